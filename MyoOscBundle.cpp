@@ -0,0 +1,70 @@
+// MyoOscBundle.cpp
+
+#include "MyoOscBundle.h"
+#include "MyoOscSender.h"
+
+#include <algorithm>
+#include <cstring>
+
+static std::size_t roundUp4(std::size_t x) {
+  return (x + 3) & ~static_cast<std::size_t>(3);
+}
+
+std::size_t bundledMessageSize(std::size_t addressLength, int argCount, std::size_t argBytes) {
+  // the type tags are a comma, one tag per argument and a terminator
+  return 4 + roundUp4(addressLength + 1) + roundUp4(argCount + 2) + argBytes;
+}
+
+// room for any message the unbundled path could send, on its own
+static std::size_t bufferSize(std::size_t limit) {
+  return std::max(limit, static_cast<std::size_t>(BUNDLE_HEADER_SIZE + 4 + OUTPUT_BUFFER_SIZE));
+}
+
+BundleBuilder::BundleBuilder(const BundleSettings& settings)
+: buffer_(bufferSize(settings.mtu - BUNDLE_IP_UDP_OVERHEAD))
+, stream_(&buffer_[0], buffer_.size())
+, limit_(settings.mtu - BUNDLE_IP_UDP_OVERHEAD)
+, messages_(0), lastSize_(0), eventTime_(0)
+, id_(OutputId::COUNT), priority_(Priority::STREAM)
+{
+  stream_.SetThrowOnError(false);
+}
+
+bool BundleBuilder::fits(std::size_t messageSize) const {
+  return messages_ == 0 || stream_.Size() + messageSize <= limit_;
+}
+
+osc::OutboundPacketStream& BundleBuilder::begin(uint64_t eventTime, uint64_t timeTag) {
+  if (messages_ == 0) {
+    stream_.Clear();
+    stream_ << osc::BeginBundle(timeTag);
+    eventTime_ = eventTime;
+    id_ = OutputId::COUNT;
+    priority_ = Priority::STREAM;
+  }
+  lastSize_ = stream_.Size();
+  return stream_;
+}
+
+std::size_t BundleBuilder::added(OutputId id, Priority priority) {
+  ++messages_;
+  if (id_ == OutputId::COUNT || (priority == Priority::EVENT && priority_ != Priority::EVENT)) {
+    id_ = id;
+    priority_ = priority;
+  }
+  return stream_.Size() - lastSize_;
+}
+
+void BundleBuilder::rollback() {
+  stream_.Rewind(lastSize_);
+}
+
+std::size_t BundleBuilder::finish() {
+  stream_ << osc::EndBundle;
+  messages_ = 0;
+  return stream_.Size();
+}
+
+void BundleBuilder::prefault() {
+  std::memset(&buffer_[0], 0, buffer_.size());
+}
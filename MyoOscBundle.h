@@ -0,0 +1,85 @@
+// MyoOscBundle.h
+//
+// Packs messages into one OSC bundle per datagram. Messages are written in
+// place after the bundle header in a buffer allocated up front, and the
+// finished bundle is handed to the sender straight from that buffer. A
+// bundle is finished once the next message wouldn't fit within the path
+// MTU (less the IP and UDP headers), so jumbo frames carry proportionally
+// more messages per datagram.
+
+#ifndef __MYO_OSC_BUNDLE_H__
+#define __MYO_OSC_BUNDLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "osc/OscOutboundPacketStream.h"
+
+#include "MyoOscSettings.h"
+
+// IPv4 and UDP headers, subtracted from the MTU
+#define BUNDLE_IP_UDP_OVERHEAD 28
+// "#bundle\0" and the time tag
+#define BUNDLE_HEADER_SIZE 16
+
+// the bytes a message takes inside a bundle: its size slot, the padded
+// address and type tags, and argBytes of arguments
+std::size_t bundledMessageSize(std::size_t addressLength, int argCount, std::size_t argBytes);
+
+class BundleBuilder {
+public:
+  explicit BundleBuilder(const BundleSettings& settings);
+
+  // the largest datagram finish() can return. a message too big to share
+  // a datagram still goes out alone, so this is more than the MTU allows
+  // when the MTU is small.
+  std::size_t capacity() const { return buffer_.size(); }
+
+  bool empty() const { return messages_ == 0; }
+
+  // true if a message of messageSize bytes (see bundledMessageSize) can be
+  // added without the datagram growing past the MTU. always true when
+  // empty.
+  bool fits(std::size_t messageSize) const;
+
+  // the stream to write the next message to, starting a bundle with
+  // timeTag if none is open. eventTime is kept for pacing.
+  osc::OutboundPacketStream& begin(uint64_t eventTime, uint64_t timeTag);
+
+  // notes a message just written to begin()'s stream, returning its size
+  std::size_t added(OutputId id, Priority priority);
+
+  // takes back whatever was written since the last begin(), e.g. a message
+  // that failed to fit, keeping the messages before it
+  void rollback();
+
+  // closes the bundle and returns its size. data() stays valid until the
+  // next begin().
+  std::size_t finish();
+
+  const char* data() const { return stream_.Data(); }
+
+  // the libmyo timestamp of the bundle's first message
+  uint64_t eventTime() const { return eventTime_; }
+  // the bundle is an event if any message in it is, and counts as the
+  // first such message's output when dropped
+  OutputId id() const { return id_; }
+  Priority priority() const { return priority_; }
+
+  // touches the buffer ahead of the first event
+  void prefault();
+
+private:
+  std::vector<char> buffer_;
+  osc::OutboundPacketStream stream_;
+  std::size_t limit_;
+  int messages_;
+  // stream size when the last message was begun
+  std::size_t lastSize_;
+  uint64_t eventTime_;
+  OutputId id_;
+  Priority priority_;
+};
+
+#endif // __MYO_OSC_BUNDLE_H__
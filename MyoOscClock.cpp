@@ -0,0 +1,102 @@
+// MyoOscClock.cpp
+
+#include "MyoOscClock.h"
+
+#include <chrono>
+#include <cmath>
+
+// seconds from the NTP epoch (1900) to the Unix epoch (1970)
+#define NTP_UNIX_OFFSET 2208988800ULL
+
+// a block minimum this far from the fit (in microseconds) means the host
+// clock was stepped, so the fit starts over
+#define CLOCK_MAX_STEP 100000
+
+ClockTranslator::ClockTranslator()
+: block_(0), window_(0) {
+  configure(TimeTagSettings());
+}
+
+void ClockTranslator::configure(const TimeTagSettings& settings) {
+  block_ = settings.block;
+  window_ = settings.window;
+  observed_ = false;
+  deviceRef_ = 0;
+  offsetRef_ = 0;
+  blockStart_ = 0;
+  blockX_ = blockY_ = 0;
+  fitted_ = false;
+  lastX_ = weight_ = 0;
+  meanX_ = meanY_ = 0;
+  cxx_ = cxy_ = 0;
+  slope_ = 0;
+}
+
+void ClockTranslator::observe(uint64_t device) {
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  observe(device, std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+void ClockTranslator::observe(uint64_t device, int64_t host) {
+  if (!observed_) {
+    deviceRef_ = device;
+    offsetRef_ = host - static_cast<int64_t>(device);
+    blockStart_ = device;
+    blockX_ = blockY_ = 0;
+    observed_ = true;
+    return;
+  }
+  double x = static_cast<double>(static_cast<int64_t>(device - deviceRef_));
+  double y = static_cast<double>(host - static_cast<int64_t>(device) - offsetRef_);
+  if (device - blockStart_ >= static_cast<uint64_t>(block_) * 1000) {
+    addPoint(blockX_, blockY_);
+    blockStart_ = device;
+    blockX_ = x;
+    blockY_ = y;
+  } else if (y < blockY_) {
+    blockX_ = x;
+    blockY_ = y;
+  }
+}
+
+void ClockTranslator::addPoint(double x, double y) {
+  if (fitted_ && std::fabs(y - (meanY_ + slope_ * (x - meanX_))) > CLOCK_MAX_STEP)
+    fitted_ = false;
+  if (!fitted_) {
+    fitted_ = true;
+    lastX_ = meanX_ = x;
+    meanY_ = y;
+    weight_ = 1;
+    cxx_ = cxy_ = 0;
+    slope_ = 0;
+    return;
+  }
+  // older points fade out over the window, so the fit follows drift that
+  // changes with temperature and the like
+  double decay = std::exp(-(x - lastX_) / (window_ * 1e6));
+  lastX_ = x;
+  weight_ = weight_ * decay + 1;
+  double dx = x - meanX_;
+  meanX_ += dx / weight_;
+  meanY_ += (y - meanY_) / weight_;
+  cxx_ = cxx_ * decay + dx * (x - meanX_);
+  cxy_ = cxy_ * decay + dx * (y - meanY_);
+  if (cxx_ > 0)
+    slope_ = cxy_ / cxx_;
+}
+
+int64_t ClockTranslator::toHost(uint64_t device) const {
+  double x = static_cast<double>(static_cast<int64_t>(device - deviceRef_));
+  double y = fitted_ ? meanY_ + slope_ * (x - meanX_) : blockY_;
+  return static_cast<int64_t>(device) + offsetRef_ + std::llround(y);
+}
+
+uint64_t ClockTranslator::toTimeTag(uint64_t device) const {
+  int64_t host = toHost(device);
+  if (host < 0)
+    return 1;
+  uint64_t micros = static_cast<uint64_t>(host);
+  uint64_t seconds = micros / 1000000 + NTP_UNIX_OFFSET;
+  uint64_t fraction = ((micros % 1000000) << 32) / 1000000;
+  return (seconds << 32) | fraction;
+}
@@ -0,0 +1,73 @@
+// MyoOscClock.h
+//
+// Translates libmyo timestamps (microseconds on the Myo's own clock) to host
+// wall-clock time, so messages can carry an OSC time tag for when the sample
+// was taken rather than when it arrived. Arrival times include a varying
+// transport delay, so only the earliest arrival of each block is used: its
+// offset is the best estimate of the true one. The block minima feed an
+// exponentially weighted linear fit of offset against device time, which
+// tracks the drift between the two clocks.
+
+#ifndef __MYO_OSC_CLOCK_H__
+#define __MYO_OSC_CLOCK_H__
+
+#include <cstdint>
+
+#include "MyoOscSettings.h"
+
+class ClockTranslator {
+public:
+  ClockTranslator();
+
+  bool differs(const TimeTagSettings& settings) const {
+    return settings.block != block_ || settings.window != window_;
+  }
+
+  // forgets everything observed so far
+  void configure(const TimeTagSettings& settings);
+
+  // pairs a libmyo timestamp with the host clock's current time
+  void observe(uint64_t device);
+  // host is in microseconds since the Unix epoch
+  void observe(uint64_t device, int64_t host);
+
+  // host time in microseconds since the Unix epoch for a libmyo timestamp.
+  // only meaningful once something has been observed.
+  int64_t toHost(uint64_t device) const;
+
+  // NTP format, as osc::TimeTag expects
+  uint64_t toTimeTag(uint64_t device) const;
+
+  // host clock rate relative to the Myo's, in parts per million
+  double drift() const { return slope_ * 1e6; }
+
+  bool synced() const { return observed_; }
+
+private:
+  void addPoint(double x, double y);
+
+  int block_;
+  float window_;
+  bool observed_;
+  // device time and host - device offset that x and y are relative to, to
+  // keep the doubles well inside their precision
+  uint64_t deviceRef_;
+  int64_t offsetRef_;
+
+  // earliest arrival in the current block
+  uint64_t blockStart_;
+  double blockX_;
+  double blockY_;
+
+  // weighted mean and co-moments of the fit
+  bool fitted_;
+  double lastX_;
+  double weight_;
+  double meanX_;
+  double meanY_;
+  double cxx_;
+  double cxy_;
+  double slope_;
+};
+
+#endif // __MYO_OSC_CLOCK_H__
@@ -0,0 +1,96 @@
+// MyoOscCompact.cpp
+
+#include "MyoOscCompact.h"
+#include "MyoOscSimd.h"
+
+#include <cstdint>
+#include <cstring>
+
+static void storeBigEndian16(char* out, uint16_t x) {
+  out[0] = static_cast<char>(x >> 8);
+  out[1] = static_cast<char>(x & 0xff);
+}
+
+// the bit manipulation equivalent of the hardware conversion, rounding the
+// mantissa to nearest even. NaNs keep their sign but not their payload.
+static uint16_t floatToHalf(float value) {
+  const uint32_t infinity = 255u << 23;
+  // the smallest float that rounds past the largest half, 65504
+  const uint32_t overflow = (127u + 16) << 23;
+  // adding this float lines a subnormal half's bits up at the bottom of the
+  // mantissa, with the FPU doing the rounding
+  const uint32_t subnormalMagic = ((127u - 15) + (23 - 10) + 1) << 23;
+
+  uint32_t x;
+  std::memcpy(&x, &value, 4);
+  uint32_t sign = x & 0x80000000u;
+  x ^= sign;
+
+  uint16_t h;
+  if (x >= overflow) {
+    h = x > infinity ? 0x7e00 : 0x7c00;
+  } else if (x < (113u << 23)) {
+    float f, magic;
+    std::memcpy(&f, &x, 4);
+    std::memcpy(&magic, &subnormalMagic, 4);
+    f += magic;
+    uint32_t bits;
+    std::memcpy(&bits, &f, 4);
+    h = static_cast<uint16_t>(bits - subnormalMagic);
+  } else {
+    uint32_t odd = (x >> 13) & 1;
+    // rebias the exponent and round, a carry out of the mantissa bumps the
+    // exponent as it should
+    x += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff + odd;
+    h = static_cast<uint16_t>(x >> 13);
+  }
+  return static_cast<uint16_t>(h | (sign >> 16));
+}
+
+void packHalf(const float* values, int count, char* out) {
+  int i = 0;
+#if defined(MYO_OSC_F16C)
+  for (; i + 4 <= count; i += 4) {
+    __m128i h = _mm_cvtps_ph(_mm_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT);
+    h = _mm_or_si128(_mm_slli_epi16(h, 8), _mm_srli_epi16(h, 8));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i * 2), h);
+  }
+#elif defined(MYO_OSC_NEON_FP16)
+  for (; i + 4 <= count; i += 4) {
+    float16x4_t h = vcvt_f16_f32(vld1q_f32(values + i));
+    vst1_u8(reinterpret_cast<uint8_t*>(out + i * 2), vrev16_u8(vreinterpret_u8_f16(h)));
+  }
+#endif
+  for (; i < count; ++i)
+    storeBigEndian16(out + i * 2, floatToHalf(values[i]));
+}
+
+void packInt16(const float* values, int count, const Range& range, char* out) {
+  // in locals, the stores through char* could otherwise alias them
+  float min = range.min;
+  float scale = 65535.0f / (range.max - range.min);
+  int i = 0;
+#if defined(MYO_OSC_SSE2)
+  const __m128 vmin = _mm_set1_ps(min);
+  const __m128 vscale = _mm_set1_ps(scale);
+  for (; i + 4 <= count; i += 4) {
+    __m128 q = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(values + i), vmin), vscale),
+                          _mm_set1_ps(0.5f));
+    // maxps returns its second operand for NaN
+    q = _mm_min_ps(_mm_max_ps(q, _mm_setzero_ps()), _mm_set1_ps(65535.0f));
+    __m128i x = _mm_sub_epi32(_mm_cvttps_epi32(q), _mm_set1_epi32(32768));
+    x = _mm_packs_epi32(x, x);
+    x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i * 2), x);
+  }
+#endif
+  for (; i < count; ++i) {
+    // offset to [0, 65535] so truncation rounds. written so that NaN fails
+    // the first comparison and ends up at the bottom
+    float q = (values[i] - min) * scale + 0.5f;
+    q = q > 0.0f ? q : 0.0f;
+    q = q < 65535.0f ? q : 65535.0f;
+    uint16_t x = static_cast<uint16_t>(static_cast<int32_t>(q) - 32768);
+    storeBigEndian16(out + i * 2, x);
+  }
+}
@@ -0,0 +1,33 @@
+// MyoOscCompact.h
+//
+// Compact encodings for float outputs on bandwidth-bound links. Instead of
+// one 32 bit float argument per value, a message carries a single blob of
+// big-endian 16 bit words: IEEE half floats, which keep about three
+// significant digits over a wide range, or int16 spread evenly over the
+// output's range, a step of (max - min) / 65535. Either is more than the
+// Myo's sensors resolve.
+
+#ifndef __MYO_OSC_COMPACT_H__
+#define __MYO_OSC_COMPACT_H__
+
+#include <cstddef>
+
+#include "MyoOscEmg.h"
+#include "MyoOscSettings.h"
+
+// the most values one compact message carries, enough for emgBands
+#define COMPACT_MAX_VALUES (EMG_CHANNELS * EMG_MAX_BANDS)
+
+// blob bytes for count values
+inline std::size_t compactSize(int count) { return static_cast<std::size_t>(count) * 2; }
+
+// rounds to the nearest half, ties to even. values beyond the half range
+// become infinities.
+void packHalf(const float* values, int count, char* out);
+
+// maps [range.min, range.max] onto [-32768, 32767], clamping values (and
+// NaNs) outside it. a receiver gets the value back as
+// min + (q + 32768) * (max - min) / 65535.
+void packInt16(const float* values, int count, const Range& range, char* out);
+
+#endif // __MYO_OSC_COMPACT_H__
@@ -0,0 +1,164 @@
+// MyoOscConfig.cpp
+
+#include "MyoOscConfig.h"
+
+#include <chrono>
+#include <iostream>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// how often the watcher checks for stop requests, and polls the file where
+// inotify isn't available
+#define WATCH_INTERVAL_MS 250
+
+SettingsHolder::SettingsHolder(const Settings& initial)
+: current_(new Settings(initial))
+, writerEpoch_(0), readerEpoch_(0) { }
+
+SettingsHolder::~SettingsHolder() {
+  delete current_.load();
+  for (const auto& r : retired_)
+    delete r.settings;
+}
+
+void SettingsHolder::replace(Settings* settings) {
+  std::lock_guard<std::mutex> lock(retiredMutex_);
+  Retired r;
+  r.settings = current_.exchange(settings, std::memory_order_acq_rel);
+  r.epoch = writerEpoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  retired_.push_back(r);
+  reclaim();
+}
+
+void SettingsHolder::reclaim() {
+  uint64_t safe = readerEpoch_.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < retired_.size(); ) {
+    if (retired_[i].epoch <= safe) {
+      delete retired_[i].settings;
+      retired_.erase(retired_.begin() + i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+static bool validPath(const OutputType& type) {
+  return !type.enabled || (!type.path.empty() && type.path[0] == '/');
+}
+
+static bool validate(const Settings& settings) {
+  const OutputType* types[] = {
+    &settings.accel, &settings.gyro, &settings.orientation, &settings.orientationQuat,
+    &settings.pose, &settings.emg, &settings.sync, &settings.rssi, &settings.emgEnvelope,
+    &settings.emgBands, &settings.worldAccel, &settings.linearAccel, &settings.worldGyro, &settings.gesture,
+    &settings.frame
+  };
+  for (auto type : types) {
+    if (!validPath(*type)) {
+      std::cerr << "Invalid OSC address for " << outputIdName(type->id) << ": "
+      << type->path << std::endl;
+      return false;
+    }
+  }
+  if (settings.gesture && settings.gestures.model.classes.empty()) {
+    std::cerr << "The gesture output needs a gesture model" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+ConfigWatcher::ConfigWatcher(const std::string& path, const Settings& base,
+                             SettingsHolder* holder)
+: path_(path)
+, base_(base)
+, holder_(holder)
+, stopping_(false) { }
+
+ConfigWatcher::~ConfigWatcher() {
+  stop();
+}
+
+void ConfigWatcher::start() {
+  stopping_ = false;
+  thread_ = std::thread(&ConfigWatcher::run, this);
+}
+
+void ConfigWatcher::stop() {
+  stopping_ = true;
+  if (thread_.joinable())
+    thread_.join();
+}
+
+bool ConfigWatcher::reload() {
+  Settings* settings = new Settings(base_);
+  if (!Settings::readJsonFile(path_, settings) || !validate(*settings)) {
+    std::cerr << "Keeping previous config, " << path_ << " is invalid" << std::endl;
+    delete settings;
+    return false;
+  }
+  const Settings* current = holder_->get();
+  if (settings->hostname != current->hostname || settings->port != current->port)
+    std::cerr << "Destination changes take effect after a restart" << std::endl;
+  holder_->replace(settings);
+  std::cout << "Reloaded " << path_ << "\n" << *settings;
+  return true;
+}
+
+static bool modifiedTime(const std::string& path, time_t* out) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0)
+    return false;
+  *out = st.st_mtime;
+  return true;
+}
+
+void ConfigWatcher::run() {
+#if defined(__linux__)
+  // editors often replace the file rather than rewrite it, so watch the
+  // directory and filter on the name
+  std::string::size_type slash = path_.rfind('/');
+  std::string dir = slash == std::string::npos ? "." : path_.substr(0, slash + 1);
+  std::string name = slash == std::string::npos ? path_ : path_.substr(slash + 1);
+  int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd >= 0 && inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0) {
+    alignas(inotify_event) char events[4096];
+    while (!stopping_) {
+      pollfd pfd = { fd, POLLIN, 0 };
+      if (poll(&pfd, 1, WATCH_INTERVAL_MS) <= 0)
+        continue;
+      bool changed = false;
+      ssize_t n;
+      while ((n = read(fd, events, sizeof(events))) > 0) {
+        for (char* p = events; p < events + n; ) {
+          const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+          if (event->len > 0 && name == event->name)
+            changed = true;
+          p += sizeof(inotify_event) + event->len;
+        }
+      }
+      if (changed)
+        reload();
+    }
+    close(fd);
+    return;
+  }
+  if (fd >= 0)
+    close(fd);
+  std::cerr << "inotify unavailable, polling " << path_ << std::endl;
+#endif
+  time_t lastModified = 0;
+  modifiedTime(path_, &lastModified);
+  while (!stopping_) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(WATCH_INTERVAL_MS));
+    time_t modified;
+    if (modifiedTime(path_, &modified) && modified != lastModified) {
+      lastModified = modified;
+      reload();
+    }
+  }
+}
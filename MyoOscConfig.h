@@ -0,0 +1,77 @@
+// MyoOscConfig.h
+//
+// Live configuration. SettingsHolder publishes immutable Settings snapshots
+// through an atomic pointer, so the libmyo callbacks read the current config
+// without taking a lock and never see a half-applied update. ConfigWatcher
+// re-reads the config file on a background thread whenever it changes.
+
+#ifndef __MYO_OSC_CONFIG_H__
+#define __MYO_OSC_CONFIG_H__
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MyoOscSettings.h"
+
+// Single reader (the hub thread), any number of writers. A replaced snapshot
+// is freed once the reader has called quiescent(), i.e. once it can no
+// longer hold a pointer to it.
+class SettingsHolder {
+public:
+  explicit SettingsHolder(const Settings& initial);
+  ~SettingsHolder();
+
+  // the current snapshot, valid until the reader's next quiescent()
+  const Settings* get() const { return current_.load(std::memory_order_acquire); }
+
+  // publishes a new snapshot and takes ownership of it
+  void replace(Settings* settings);
+
+  // called by the reader between callbacks, when it holds no snapshot
+  void quiescent() {
+    readerEpoch_.store(writerEpoch_.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+private:
+  struct Retired {
+    const Settings* settings;
+    uint64_t epoch;
+  };
+
+  void reclaim();
+
+  std::atomic<const Settings*> current_;
+  std::atomic<uint64_t> writerEpoch_;
+  std::atomic<uint64_t> readerEpoch_;
+  std::mutex retiredMutex_;
+  std::vector<Retired> retired_;
+};
+
+class ConfigWatcher {
+public:
+  // each reload starts from base and applies the file on top of it, the
+  // same way --config does at startup
+  ConfigWatcher(const std::string& path, const Settings& base, SettingsHolder* holder);
+  ~ConfigWatcher();
+
+  void start();
+  void stop();
+
+  // re-reads the file and publishes it if it parses and validates
+  bool reload();
+
+private:
+  void run();
+
+  std::string path_;
+  Settings base_;
+  SettingsHolder* holder_;
+  std::thread thread_;
+  std::atomic<bool> stopping_;
+};
+
+#endif // __MYO_OSC_CONFIG_H__
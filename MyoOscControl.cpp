@@ -0,0 +1,66 @@
+// MyoOscControl.cpp
+
+#include "MyoOscControl.h"
+
+#include <cstring>
+#include <iostream>
+
+ControlReceiver::ControlReceiver(const ControlSettings& settings, Calibration* calibration)
+: calibration_(calibration)
+, socket_(nullptr)
+{
+  socket_ = new UdpListeningReceiveSocket(IpEndpointName(IpEndpointName::ANY_ADDRESS, settings.port), this);
+}
+
+ControlReceiver::~ControlReceiver() {
+  stop();
+  if (socket_ != nullptr) {
+    delete socket_;
+  }
+}
+
+void ControlReceiver::start() {
+  thread_ = std::thread([this] { socket_->Run(); });
+}
+
+void ControlReceiver::stop() {
+  if (thread_.joinable()) {
+    socket_->AsynchronousBreak();
+    thread_.join();
+  }
+}
+
+void ControlReceiver::ProcessMalformedPacket(const char* error, const IpEndpointName& remoteEndpoint) {
+  (void)remoteEndpoint;
+  std::cerr << "Error in control message: " << error << std::endl;
+}
+
+void ControlReceiver::ProcessMessage(const osc::ReceivedMessage& m, const IpEndpointName& remoteEndpoint) {
+  const char* address = m.AddressPattern();
+  if (std::strcmp(address, "/myo-osc/calibrate") == 0) {
+    if (m.ArgumentCount() == 0) {
+      calibration_->requestCapture();
+      return;
+    }
+    // m has already been validated, so after one signature check the
+    // arguments are read straight from their offsets
+    if (m.ArgumentCount() == 4) {
+      osc::IndexedReceivedMessage message(m);
+      if (message.Matches(",ffff")) {
+        myo::Quaternion<float> reference(message.AsFloatUnchecked(0), message.AsFloatUnchecked(1),
+                                         message.AsFloatUnchecked(2), message.AsFloatUnchecked(3));
+        // anyone can send to this port, so a bad reference mustn't get
+        // as far as the hub thread
+        if (!Calibration::isValidReference(reference)) {
+          ProcessMalformedPacket("reference quaternion not finite or too close to zero", remoteEndpoint);
+          return;
+        }
+        calibration_->requestReference(reference);
+        return;
+      }
+    }
+    ProcessMalformedPacket("wrong argument type", remoteEndpoint);
+  } else if (std::strcmp(address, "/myo-osc/calibrate/reset") == 0) {
+    calibration_->requestReset();
+  }
+}
@@ -0,0 +1,41 @@
+// MyoOscControl.h
+//
+// Inbound OSC control channel. Listens on its own UDP port and thread and
+// turns commands into requests for the hub thread:
+//
+//   /myo-osc/calibrate              take the current orientation as reference
+//   /myo-osc/calibrate f x f y f z f w   use this quaternion as reference
+//   /myo-osc/calibrate/reset        back to the device's own frame
+
+#ifndef __MYO_OSC_CONTROL_H__
+#define __MYO_OSC_CONTROL_H__
+
+#include <thread>
+
+#include "osc/OscPacketListener.h"
+#include "ip/UdpSocket.h"
+
+#include "MyoOscOrientation.h"
+#include "MyoOscSettings.h"
+
+class ControlReceiver : public osc::OscPacketListener {
+public:
+  ControlReceiver(const ControlSettings& settings, Calibration* calibration);
+  ~ControlReceiver();
+
+  void start();
+  void stop();
+
+protected:
+  void ProcessMessage(const osc::ReceivedMessage& m, const IpEndpointName& remoteEndpoint) override;
+  // malformed packets, and commands with the wrong arguments, are reported
+  // and dropped rather than ending the thread
+  void ProcessMalformedPacket(const char* error, const IpEndpointName& remoteEndpoint) override;
+
+private:
+  Calibration* calibration_;
+  UdpListeningReceiveSocket* socket_;
+  std::thread thread_;
+};
+
+#endif // __MYO_OSC_CONTROL_H__
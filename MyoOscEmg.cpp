@@ -0,0 +1,163 @@
+// MyoOscEmg.cpp
+
+#include "MyoOscEmg.h"
+
+#include <algorithm>
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <cstdlib>
+
+EmgEnvelope::EmgEnvelope()
+: window_(0), cutoff_(0), alpha_(1), filled_(0), pos_(0) {
+  configure(EnvelopeSettings());
+}
+
+void EmgEnvelope::configure(const EnvelopeSettings& settings) {
+  if (settings.window != window_)
+    squares_.assign(settings.window * EMG_CHANNELS, 0);
+  else
+    std::fill(squares_.begin(), squares_.end(), 0);
+  window_ = settings.window;
+  cutoff_ = settings.cutoff;
+  // one-pole low-pass, y += alpha * (x - y)
+  alpha_ = 1.0f - std::exp(-2.0f * static_cast<float>(M_PI) * cutoff_ / EMG_SAMPLE_RATE);
+  filled_ = 0;
+  pos_ = 0;
+  for (int c = 0; c < EMG_CHANNELS; ++c) {
+    sums_[c] = 0;
+    rms_[c] = 0;
+    envelope_[c] = 0;
+  }
+}
+
+void EmgEnvelope::process(const int8_t* emg) {
+  int32_t* row = &squares_[pos_ * EMG_CHANNELS];
+  if (filled_ < window_)
+    ++filled_;
+  float scale = 1.0f / filled_;
+  for (int c = 0; c < EMG_CHANNELS; ++c) {
+    int32_t x = emg[c];
+    int32_t square = x * x;
+    sums_[c] += square - row[c];
+    row[c] = square;
+    rms_[c] = std::sqrt(sums_[c] * scale);
+    envelope_[c] += alpha_ * (static_cast<float>(std::abs(x)) - envelope_[c]);
+  }
+  if (++pos_ == window_)
+    pos_ = 0;
+}
+
+// damping per sample for the sliding DFT
+#define SDFT_DAMPING 0.9999
+
+EmgBands::EmgBands()
+: damping_(1), pos_(0), filled_(0), sinceHop_(0) {
+  settings_.window = 0;
+  configure(BandSettings());
+}
+
+bool EmgBands::differs(const BandSettings& settings) const {
+  if (settings.window != settings_.window || settings.hop != settings_.hop ||
+      settings.bands.size() != settings_.bands.size())
+    return true;
+  for (std::size_t i = 0; i < settings.bands.size(); ++i) {
+    if (settings.bands[i].low != settings_.bands[i].low ||
+        settings.bands[i].high != settings_.bands[i].high)
+      return true;
+  }
+  return false;
+}
+
+void EmgBands::configure(const BandSettings& settings) {
+  settings_ = settings;
+  int n = settings_.window;
+  float binWidth = EMG_SAMPLE_RATE / n;
+  
+  bins_.clear();
+  bandBins_.assign(settings_.bands.size(), std::vector<int>());
+  for (int k = 0; k <= n / 2; ++k) {
+    float freq = k * binWidth;
+    int index = -1;
+    for (std::size_t b = 0; b < settings_.bands.size(); ++b) {
+      const FrequencyBand& band = settings_.bands[b];
+      // a band reaching Nyquist includes it
+      bool inside = freq >= band.low &&
+      (freq < band.high || (k == n / 2 && freq <= band.high));
+      if (!inside)
+        continue;
+      if (index < 0) {
+        index = static_cast<int>(bins_.size());
+        bins_.push_back(k);
+      }
+      bandBins_[b].push_back(index);
+    }
+  }
+  
+  twiddleRe_.resize(bins_.size());
+  twiddleIm_.resize(bins_.size());
+  for (std::size_t i = 0; i < bins_.size(); ++i) {
+    double theta = 2 * M_PI * bins_[i] / n;
+    twiddleRe_[i] = static_cast<float>(SDFT_DAMPING * std::cos(theta));
+    twiddleIm_[i] = static_cast<float>(SDFT_DAMPING * std::sin(theta));
+  }
+  damping_ = static_cast<float>(std::pow(SDFT_DAMPING, n));
+  
+  ring_.assign(n * EMG_CHANNELS, 0.0f);
+  re_.assign(bins_.size() * EMG_CHANNELS, 0.0f);
+  im_.assign(bins_.size() * EMG_CHANNELS, 0.0f);
+  pos_ = 0;
+  filled_ = 0;
+  sinceHop_ = 0;
+  std::fill(powers_, powers_ + EMG_CHANNELS * EMG_MAX_BANDS, 0.0f);
+}
+
+bool EmgBands::process(const int8_t* emg) {
+  float delta[EMG_CHANNELS];
+  float* row = &ring_[pos_ * EMG_CHANNELS];
+  for (int c = 0; c < EMG_CHANNELS; ++c) {
+    float x = emg[c];
+    delta[c] = x - damping_ * row[c];
+    row[c] = x;
+  }
+  if (++pos_ == settings_.window)
+    pos_ = 0;
+  
+  // S_k = r e^(j 2 pi k / N) S_k + x(n) - r^N x(n - N)
+  for (std::size_t i = 0; i < bins_.size(); ++i) {
+    float tr = twiddleRe_[i];
+    float ti = twiddleIm_[i];
+    float* re = &re_[i * EMG_CHANNELS];
+    float* im = &im_[i * EMG_CHANNELS];
+    for (int c = 0; c < EMG_CHANNELS; ++c) {
+      float r = re[c];
+      float m = im[c];
+      re[c] = tr * r - ti * m + delta[c];
+      im[c] = tr * m + ti * r;
+    }
+  }
+  
+  if (filled_ < settings_.window)
+    ++filled_;
+  if (++sinceHop_ < settings_.hop || filled_ < settings_.window)
+    return false;
+  sinceHop_ = 0;
+  
+  int n = settings_.window;
+  float norm = 1.0f / (static_cast<float>(n) * n);
+  int bandCount = static_cast<int>(settings_.bands.size());
+  for (int b = 0; b < bandCount; ++b) {
+    float power[EMG_CHANNELS] = { 0 };
+    for (int index : bandBins_[b]) {
+      int k = bins_[index];
+      // one-sided spectrum: every bin but DC and Nyquist stands for two
+      float weight = (k == 0 || 2 * k == n) ? norm : 2 * norm;
+      const float* re = &re_[index * EMG_CHANNELS];
+      const float* im = &im_[index * EMG_CHANNELS];
+      for (int c = 0; c < EMG_CHANNELS; ++c)
+        power[c] += weight * (re[c] * re[c] + im[c] * im[c]);
+    }
+    for (int c = 0; c < EMG_CHANNELS; ++c)
+      powers_[c * bandCount + b] = power[c];
+  }
+  return true;
+}
@@ -0,0 +1,94 @@
+// MyoOscEmg.h
+//
+// Streaming EMG features. EmgEnvelope keeps a per-channel running sum of
+// squares over a ring of the last N samples, so the moving RMS costs the
+// same per sample whatever the window length, plus a one-pole low-pass over
+// the rectified signal. EmgBands tracks band powers with a sliding DFT.
+
+#ifndef __MYO_OSC_EMG_H__
+#define __MYO_OSC_EMG_H__
+
+#include <cstdint>
+#include <vector>
+
+#include "MyoOscSettings.h"
+
+#define EMG_CHANNELS 8
+#define EMG_SAMPLE_RATE 200.0f
+
+class EmgEnvelope {
+public:
+  EmgEnvelope();
+
+  // resets the state; only allocates when the window length changes
+  void configure(const EnvelopeSettings& settings);
+
+  // true if configure() would change anything
+  bool differs(const EnvelopeSettings& settings) const {
+    return settings.window != window_ || settings.cutoff != cutoff_;
+  }
+
+  void process(const int8_t* emg);
+
+  const float* rms() const { return rms_; }
+  const float* envelope() const { return envelope_; }
+
+private:
+  int window_;
+  float cutoff_;
+  float alpha_;
+  // samples seen so far, up to window_
+  int filled_;
+  int pos_;
+  // squared samples, window_ rows of EMG_CHANNELS. squares of int8_t are
+  // exact in integers, so the running sums never drift.
+  std::vector<int32_t> squares_;
+  int64_t sums_[EMG_CHANNELS];
+  float rms_[EMG_CHANNELS];
+  float envelope_[EMG_CHANNELS];
+};
+
+// Sliding DFT over the last window samples of each channel. Only the bins
+// that fall inside a configured band are tracked, each updated in O(1) per
+// sample with a precomputed twiddle, so a hop costs hop * bins * channels
+// multiply-adds however long the window is. The twiddles are damped
+// slightly (r < 1) to keep float rounding from accumulating.
+class EmgBands {
+public:
+  EmgBands();
+
+  bool differs(const BandSettings& settings) const;
+
+  // resets the state; allocates, so only call it when the settings change
+  void configure(const BandSettings& settings);
+
+  // returns true at the end of each hop, once the window has filled
+  bool process(const int8_t* emg);
+
+  // signal power in each band, all bands of channel 0 first, then channel 1...
+  const float* powers() const { return powers_; }
+  int count() const { return EMG_CHANNELS * static_cast<int>(settings_.bands.size()); }
+
+private:
+  BandSettings settings_;
+  // DFT bin numbers being tracked
+  std::vector<int> bins_;
+  // for each band, indices into bins_
+  std::vector<std::vector<int> > bandBins_;
+  // r * e^(j 2 pi k / N) for each tracked bin
+  std::vector<float> twiddleRe_;
+  std::vector<float> twiddleIm_;
+  // r^N, applied to the sample leaving the window
+  float damping_;
+  // window rows of EMG_CHANNELS samples
+  std::vector<float> ring_;
+  // bins_.size() rows of EMG_CHANNELS values
+  std::vector<float> re_;
+  std::vector<float> im_;
+  int pos_;
+  int filled_;
+  int sinceHop_;
+  float powers_[EMG_CHANNELS * EMG_MAX_BANDS];
+};
+
+#endif // __MYO_OSC_EMG_H__
@@ -0,0 +1,111 @@
+// MyoOscFilter.cpp
+
+#include "MyoOscFilter.h"
+
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+Biquad designBiquad(const FilterSpec& spec, float sampleRate) {
+  if (!(spec.freq > 0 && spec.freq < sampleRate / 2))
+    throw std::invalid_argument("Filter frequency must be between 0 and " +
+                                std::to_string(sampleRate / 2) + "Hz");
+  if (!(spec.q > 0))
+    throw std::invalid_argument("Filter q must be positive");
+  double w0 = 2 * M_PI * spec.freq / sampleRate;
+  double cosw = std::cos(w0);
+  double alpha = std::sin(w0) / (2 * spec.q);
+  double b0, b1, b2;
+  switch (spec.kind) {
+    case FilterKind::HIGHPASS:
+      b0 = (1 + cosw) / 2;
+      b1 = -(1 + cosw);
+      b2 = (1 + cosw) / 2;
+      break;
+    case FilterKind::BANDPASS:
+      // constant 0dB peak gain
+      b0 = alpha;
+      b1 = 0;
+      b2 = -alpha;
+      break;
+    case FilterKind::NOTCH:
+      b0 = 1;
+      b1 = -2 * cosw;
+      b2 = 1;
+      break;
+    case FilterKind::LOWPASS:
+    default:
+      b0 = (1 - cosw) / 2;
+      b1 = 1 - cosw;
+      b2 = (1 - cosw) / 2;
+      break;
+  }
+  double a0 = 1 + alpha;
+  Biquad biquad;
+  biquad.b0 = static_cast<float>(b0 / a0);
+  biquad.b1 = static_cast<float>(b1 / a0);
+  biquad.b2 = static_cast<float>(b2 / a0);
+  biquad.a1 = static_cast<float>(-2 * cosw / a0);
+  biquad.a2 = static_cast<float>((1 - alpha) / a0);
+  return biquad;
+}
+
+FilterBank::FilterBank(int channels)
+: channels_(channels)
+, lanes_((channels + FILTER_GROUP - 1) / FILTER_GROUP * FILTER_GROUP) { }
+
+void FilterBank::configure(const std::vector<Biquad>& biquads) {
+  biquads_ = biquads;
+  state_.assign(biquads_.size() * lanes_ * 2, 0.0f);
+}
+
+void FilterBank::process(float* samples) {
+  float lanes[FILTER_MAX_CHANNELS];
+  std::copy(samples, samples + channels_, lanes);
+  std::fill(lanes + channels_, lanes + lanes_, 0.0f);
+  
+  float* z = state_.data();
+  for (const auto& bq : biquads_) {
+    float* z1 = z;
+    float* z2 = z + lanes_;
+    // transposed direct form II
+    for (int g = 0; g < lanes_; g += FILTER_GROUP) {
+#if defined(MYO_OSC_SSE)
+      __m128 x = _mm_loadu_ps(lanes + g);
+      __m128 s1 = _mm_loadu_ps(z1 + g);
+      __m128 s2 = _mm_loadu_ps(z2 + g);
+      __m128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(bq.b0), x), s1);
+      s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(bq.b1), x),
+                                 _mm_mul_ps(_mm_set1_ps(bq.a1), y)), s2);
+      s2 = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(bq.b2), x),
+                      _mm_mul_ps(_mm_set1_ps(bq.a2), y));
+      _mm_storeu_ps(lanes + g, y);
+      _mm_storeu_ps(z1 + g, s1);
+      _mm_storeu_ps(z2 + g, s2);
+#elif defined(MYO_OSC_NEON)
+      float32x4_t x = vld1q_f32(lanes + g);
+      float32x4_t s1 = vld1q_f32(z1 + g);
+      float32x4_t s2 = vld1q_f32(z2 + g);
+      float32x4_t y = vmlaq_n_f32(s1, x, bq.b0);
+      s1 = vmlsq_n_f32(vmlaq_n_f32(s2, x, bq.b1), y, bq.a1);
+      s2 = vmlsq_n_f32(vmulq_n_f32(x, bq.b2), y, bq.a2);
+      vst1q_f32(lanes + g, y);
+      vst1q_f32(z1 + g, s1);
+      vst1q_f32(z2 + g, s2);
+#else
+      for (int i = g; i < g + FILTER_GROUP; ++i) {
+        float x = lanes[i];
+        float y = bq.b0 * x + z1[i];
+        z1[i] = bq.b1 * x - bq.a1 * y + z2[i];
+        z2[i] = bq.b2 * x - bq.a2 * y;
+        lanes[i] = y;
+      }
+#endif
+    }
+    z += lanes_ * 2;
+  }
+  
+  std::copy(lanes, lanes + channels_, samples);
+}
@@ -0,0 +1,70 @@
+// MyoOscFilter.h
+//
+// Cascaded biquad filters for the EMG and IMU streams. Coefficients are
+// designed once when the config is read (RBJ audio EQ cookbook formulas) and
+// stored on the OutputType; FilterBank holds the per-channel state and runs
+// every channel of a sample in parallel, one SIMD lane per channel.
+
+#ifndef __MYO_OSC_FILTER_H__
+#define __MYO_OSC_FILTER_H__
+
+#include <vector>
+
+#include "MyoOscSimd.h"
+
+// lanes per SIMD group; channels are padded up to a multiple of this
+#define FILTER_GROUP 4
+#define FILTER_MAX_CHANNELS 8
+
+enum class FilterKind {
+  LOWPASS,
+  HIGHPASS,
+  BANDPASS,
+  NOTCH
+};
+
+struct FilterSpec {
+  FilterKind kind;
+  // corner or center frequency in Hz
+  float freq;
+  float q;
+
+  FilterSpec() : kind(FilterKind::LOWPASS), freq(0), q(0.7071f) { }
+};
+
+// normalized so a0 == 1
+struct Biquad {
+  float b0, b1, b2, a1, a2;
+
+  bool operator==(const Biquad& other) const {
+    return b0 == other.b0 && b1 == other.b1 && b2 == other.b2 &&
+    a1 == other.a1 && a2 == other.a2;
+  }
+  bool operator!=(const Biquad& other) const { return !(*this == other); }
+};
+
+// throws std::invalid_argument if freq isn't below Nyquist or q isn't positive
+Biquad designBiquad(const FilterSpec& spec, float sampleRate);
+
+class FilterBank {
+public:
+  explicit FilterBank(int channels);
+
+  // true if configure(biquads) would change the cascade
+  bool differs(const std::vector<Biquad>& biquads) const { return biquads != biquads_; }
+
+  // replaces the cascade and clears the filter state
+  void configure(const std::vector<Biquad>& biquads);
+
+  // filters one sample of every channel in place
+  void process(float* samples);
+
+private:
+  int channels_;
+  int lanes_;
+  std::vector<Biquad> biquads_;
+  // for each stage, lanes_ values of z1 followed by lanes_ values of z2
+  std::vector<float> state_;
+};
+
+#endif // __MYO_OSC_FILTER_H__
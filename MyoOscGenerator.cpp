@@ -12,11 +12,14 @@
 
 
 #include "MyoOscGenerator.h"
+#include "MyoOscCompact.h"
 
 #define _USE_MATH_DEFINES
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <cfloat>
+#include <cstring>
 
 //check for division by zero???
 //--------------------------------------------------
@@ -27,56 +30,65 @@
 //    return outputMin;
 //  }
 
+// clamps is incremented whenever a value had to be clamped to the output range
 static float mapValue(float value, Range inRange,
-                      Range outRange, bool clamp) {
+                      Range outRange, bool clamp, unsigned* clamps) {
 //  if (fabs(inRange.min - inRange.max) < FLT_EPSILON)
   float outVal = ((value - inRange.min) / (inRange.max - inRange.min) * (outRange.max - outRange.min) + outRange.min);
   if (clamp) {
     if (outRange.max < outRange.min) {
-      if (outVal < outRange.max)
+      if (outVal < outRange.max) {
+        ++*clamps;
         return outRange.max;
-      if (outVal > outRange.min)
+      }
+      if (outVal > outRange.min) {
+        ++*clamps;
         return outRange.min;
+      }
     } else {
-      if (outVal < outRange.min)
+      if (outVal < outRange.min) {
+        ++*clamps;
         return outRange.min;
-      if (outVal > outRange.max)
+      }
+      if (outVal > outRange.max) {
+        ++*clamps;
         return outRange.max;
+      }
     }
   }
   return outVal;
 }
 
-static float scale(float value, const OutputType& type) {
+static float scale(float value, const OutputType& type, unsigned* clamps) {
   if (type.scaling == Scaling::SCALE)
-    return mapValue(value, type.inrange, type.outrange, false);
+    return mapValue(value, type.inrange, type.outrange, false, clamps);
   else if(type.scaling == Scaling::CLAMP)
-    return mapValue(value, type.inrange, type.outrange, true);
+    return mapValue(value, type.inrange, type.outrange, true, clamps);
   else
     return value;
 }
 
-static myo::Vector3<float> scale(myo::Vector3<float> value, const OutputType& type) {
+static myo::Vector3<float> scale(myo::Vector3<float> value, const OutputType& type, unsigned* clamps) {
   if (type.scaling == Scaling::NONE)
     return value;
-  return myo::Vector3<float>(scale(value.x(), type),
-                             scale(value.y(), type),
-                             scale(value.z(), type));
+  return myo::Vector3<float>(scale(value.x(), type, clamps),
+                             scale(value.y(), type, clamps),
+                             scale(value.z(), type, clamps));
 }
 
-static myo::Quaternion<float> scale(myo::Quaternion<float> value, const OutputType& type) {
+static myo::Quaternion<float> scale(myo::Quaternion<float> value, const OutputType& type, unsigned* clamps) {
   if (type.scaling == Scaling::NONE)
     return value;
-  return myo::Quaternion<float>(scale(value.x(), type),
-                                scale(value.y(), type),
-                                scale(value.z(), type),
-                                scale(value.w(), type));
+  return myo::Quaternion<float>(scale(value.x(), type, clamps),
+                                scale(value.y(), type, clamps),
+                                scale(value.z(), type, clamps),
+                                scale(value.w(), type, clamps));
 }
 
-static int8_t scale(int8_t value, const OutputType& type) {
+static int8_t scale(int8_t value, const OutputType& type, unsigned* clamps) {
   if (type.scaling == Scaling::NONE)
     return value;
-  return static_cast<int8_t>(scale(static_cast<float>(value), type));
+  return static_cast<int8_t>(scale(static_cast<float>(value), type, clamps));
 }
 
 static void logPath(const std::string& path) {
@@ -105,34 +117,99 @@ static void logQuaterion(const myo::Quaternion<float>& quat) {
 }
 
 void MyoOscGenerator::sendMessage(const OutputType& type, int8_t val) {
-  send(beginMessage(type.path)
-       << scale(val, type) << osc::EndMessage);
-  if (settings.logOsc) {
+  unsigned clamps = 0;
+  val = scale(val, type, &clamps);
+  stats->countClamps(type.id, clamps);
+  send(type, beginPacket(bundledMessageSize(type.path.size(), 1, 4))
+       .WriteMessage(type.path.c_str(), static_cast<osc::int32>(val)));
+  if (active->logOsc) {
     logPath(type.path);
-    logVal(scale(val, type));
+    logVal(val);
     std::cout << std::endl;
   }
 }
 
 void MyoOscGenerator::sendMessage(const OutputType& type, const int8_t* vals, int count) {
-  auto p = beginMessage(type.path);
-  for (int i = 0; i < count; ++i) {
-    p << scale(vals[i], type);
+  unsigned clamps = 0;
+  if (type.encoding != Encoding::FLOAT && count <= COMPACT_MAX_VALUES) {
+    float scaled[COMPACT_MAX_VALUES];
+    for (int i = 0; i < count; ++i)
+      scaled[i] = scale(vals[i], type, &clamps);
+    stats->countClamps(type.id, clamps);
+    sendCompact(type, scaled, count);
+  } else if (count == EMG_CHANNELS) {
+    // raw EMG, the one shape that comes through here
+    osc::int32 scaled[EMG_CHANNELS];
+    for (int i = 0; i < EMG_CHANNELS; ++i)
+      scaled[i] = scale(vals[i], type, &clamps);
+    stats->countClamps(type.id, clamps);
+    send(type, beginPacket(bundledMessageSize(type.path.size(), EMG_CHANNELS, EMG_CHANNELS * 4))
+         .WriteRepeatedMessage<EMG_CHANNELS>(type.path.c_str(), scaled));
+  } else {
+    auto& p = beginMessage(type.path, bundledMessageSize(type.path.size(), count, count * 4));
+    for (int i = 0; i < count; ++i) {
+      p << scale(vals[i], type, &clamps);
+    }
+    stats->countClamps(type.id, clamps);
+    send(type, p << osc::EndMessage);
   }
-  send(p << osc::EndMessage);
-  if (settings.logOsc) {
+  if (active->logOsc) {
     logPath(type.path);
     for (int i = 0; i < count; ++i) {
-      logVal(scale(vals[i], type));
+      logVal(scale(vals[i], type, &clamps));
+    }
+    std::cout << std::endl;
+  }
+}
+
+void MyoOscGenerator::sendMessage(const OutputType& type, const float* vals, int count) {
+  unsigned clamps = 0;
+  if (type.encoding != Encoding::FLOAT && count <= COMPACT_MAX_VALUES) {
+    float scaled[COMPACT_MAX_VALUES];
+    for (int i = 0; i < count; ++i)
+      scaled[i] = scale(vals[i], type, &clamps);
+    stats->countClamps(type.id, clamps);
+    sendCompact(type, scaled, count);
+  } else if (count == EMG_CHANNELS || count == EMG_CHANNELS * 2) {
+    // filtered EMG and the envelope have fixed shapes, band powers depend
+    // on the configuration and go through the stream
+    float scaled[EMG_CHANNELS * 2];
+    for (int i = 0; i < count; ++i)
+      scaled[i] = scale(vals[i], type, &clamps);
+    stats->countClamps(type.id, clamps);
+    osc::OutboundPacketStream& p = beginPacket(bundledMessageSize(type.path.size(), count, count * 4));
+    if (count == EMG_CHANNELS)
+      p.WriteRepeatedMessage<EMG_CHANNELS>(type.path.c_str(), scaled);
+    else
+      p.WriteRepeatedMessage<EMG_CHANNELS * 2>(type.path.c_str(), scaled);
+    send(type, p);
+  } else {
+    // scaled a run at a time and converted to OSC byte order in bulk
+    auto& p = beginMessage(type.path, bundledMessageSize(type.path.size(), count, count * 4));
+    float scaled[EMG_CHANNELS * 2];
+    for (int i = 0; i < count; i += EMG_CHANNELS * 2) {
+      int run = std::min(count - i, EMG_CHANNELS * 2);
+      for (int j = 0; j < run; ++j)
+        scaled[j] = scale(vals[i + j], type, &clamps);
+      p.WriteFloats(scaled, run);
+    }
+    stats->countClamps(type.id, clamps);
+    send(type, p << osc::EndMessage);
+  }
+  if (active->logOsc) {
+    logPath(type.path);
+    for (int i = 0; i < count; ++i) {
+      logVal(scale(vals[i], type, &clamps));
     }
     std::cout << std::endl;
   }
 }
 
 void MyoOscGenerator::sendMessage(const OutputType& type, const char* val) {
-  send(beginMessage(type.path)
-       << val << osc::EndMessage);
-  if (settings.logOsc) {
+  std::size_t argBytes = (std::strlen(val) + 4) & ~static_cast<std::size_t>(3);
+  send(type, beginPacket(bundledMessageSize(type.path.size(), 1, argBytes))
+       .WriteMessage(type.path.c_str(), val));
+  if (active->logOsc) {
     logPath(type.path);
     std::cout << "  " << std::right << val;
     std::cout << std::endl;
@@ -140,10 +217,21 @@ void MyoOscGenerator::sendMessage(const OutputType& type, const char* val) {
 }
 
 void MyoOscGenerator::sendMessage(const OutputType& type, myo::Vector3<float> vec) {
-  vec = scale(vec, type);
-  send(beginMessage(type.path)
-       << vec.x() << vec.y() << vec.z() << osc::EndMessage);
-  if (settings.logOsc) {
+  unsigned clamps = 0;
+  vec = scale(vec, type, &clamps);
+  stats->countClamps(type.id, clamps);
+  sendVector(type, vec);
+}
+
+void MyoOscGenerator::sendVector(const OutputType& type, const myo::Vector3<float>& vec) {
+  if (type.encoding != Encoding::FLOAT) {
+    float values[3] = { vec.x(), vec.y(), vec.z() };
+    sendCompact(type, values, 3);
+  } else {
+    send(type, beginPacket(bundledMessageSize(type.path.size(), 3, 12))
+         .WriteMessage(type.path.c_str(), vec.x(), vec.y(), vec.z()));
+  }
+  if (active->logOsc) {
     logPath(type.path);
     logVector(vec);
     std::cout << std::endl;
@@ -151,12 +239,20 @@ void MyoOscGenerator::sendMessage(const OutputType& type, myo::Vector3<float> ve
 }
 
 void MyoOscGenerator::sendMessage(const OutputType& type, myo::Vector3<float> vec1, myo::Vector3<float> vec2) {
-  vec1 = scale(vec1, type);
-  vec2 = scale(vec2, type);
-  send(beginMessage(type.path)
-       << vec1.x() << vec1.y() << vec1.z()
-       << vec2.x() << vec2.y() << vec2.z() << osc::EndMessage);
-  if (settings.logOsc) {
+  unsigned clamps = 0;
+  vec1 = scale(vec1, type, &clamps);
+  vec2 = scale(vec2, type, &clamps);
+  stats->countClamps(type.id, clamps);
+  if (type.encoding != Encoding::FLOAT) {
+    float values[6] = { vec1.x(), vec1.y(), vec1.z(), vec2.x(), vec2.y(), vec2.z() };
+    sendCompact(type, values, 6);
+  } else {
+    send(type, beginPacket(bundledMessageSize(type.path.size(), 6, 24))
+         .WriteMessage(type.path.c_str(),
+                       vec1.x(), vec1.y(), vec1.z(),
+                       vec2.x(), vec2.y(), vec2.z()));
+  }
+  if (active->logOsc) {
     logPath(type.path);
     logVector(vec1);
     logVector(vec2);
@@ -165,77 +261,354 @@ void MyoOscGenerator::sendMessage(const OutputType& type, myo::Vector3<float> ve
 }
 
 void MyoOscGenerator::sendMessage(const OutputType& type, myo::Quaternion<float> quat) {
-  quat = scale(quat, type);
-  send(beginMessage(type.path)
-       << quat.x() << quat.y() << quat.z() << quat.w() << osc::EndMessage);
-  if (settings.logOsc) {
+  unsigned clamps = 0;
+  quat = scale(quat, type, &clamps);
+  stats->countClamps(type.id, clamps);
+  if (type.encoding != Encoding::FLOAT) {
+    float values[4] = { quat.x(), quat.y(), quat.z(), quat.w() };
+    sendCompact(type, values, 4);
+  } else {
+    send(type, beginPacket(bundledMessageSize(type.path.size(), 4, 16))
+         .WriteMessage(type.path.c_str(), quat.x(), quat.y(), quat.z(), quat.w()));
+  }
+  if (active->logOsc) {
     logPath(type.path);
     logQuaterion(quat);
     std::cout << std::endl;
   }
 }
 
-MyoOscGenerator::MyoOscGenerator(Settings settings)
-: settings(settings)
+void MyoOscGenerator::sendCompact(const OutputType& type, const float* vals, int count) {
+  char packed[COMPACT_MAX_VALUES * 2];
+  if (type.encoding == Encoding::HALF)
+    packHalf(vals, count, packed);
+  else
+    packInt16(vals, count, type.outrange, packed);
+  std::size_t size = compactSize(count);
+  std::size_t argBytes = 4 + ((size + 3) & ~static_cast<std::size_t>(3));
+  send(type, beginPacket(bundledMessageSize(type.path.size(), 1, argBytes))
+       .WriteMessage(type.path.c_str(), osc::Blob(packed, static_cast<osc::osc_bundle_element_size_t>(size))));
+}
+
+void MyoOscGenerator::sendGesture(const OutputType& type, const std::string& name, float score) {
+  std::size_t argBytes = ((name.size() + 4) & ~static_cast<std::size_t>(3)) + 4;
+  send(type, beginPacket(bundledMessageSize(type.path.size(), 2, argBytes))
+       .WriteMessage(type.path.c_str(), name.c_str(), score));
+  if (active->logOsc) {
+    logPath(type.path);
+    std::cout << "  " << std::right << name;
+    logVal(score);
+    std::cout << std::endl;
+  }
+}
+
+void MyoOscGenerator::sendFrame(const OutputType& type, uint64_t timestamp, const float* vals, int count) {
+  auto& p = beginMessage(type.path, bundledMessageSize(type.path.size(), count + 1, 8 + count * 4));
+  p << static_cast<osc::int64>(timestamp);
+  for (int i = 0; i < count; ++i)
+    p << vals[i];
+  send(type, p << osc::EndMessage);
+  if (active->logOsc) {
+    logPath(type.path);
+    std::cout << "  " << timestamp;
+    for (int i = 0; i < count; ++i)
+      logVal(vals[i]);
+    std::cout << std::endl;
+  }
+}
+
+MyoOscGenerator::MyoOscGenerator(SettingsHolder* config, Stats* stats)
+: packet(buffer, OUTPUT_BUFFER_SIZE)
+, config(config)
+, active(config->get())
+, eventTime(0)
+, stats(stats)
+, batchedFrames(0), batchWidth(0), batchTime(0)
+, accelFilter(3), gyroFilter(3), emgFilter(EMG_CHANNELS)
+, orientationPending(false), pendingTimestamp(0)
+, rotationTimestamp(0), haveRotation(false)
 {
-  transmitSocket = new UdpTransmitSocket(IpEndpointName(settings.hostname.c_str(), settings.port));
+  // overflows are checked once per message in send()
+  packet.SetThrowOnError(false);
+  bundler = active->bundle.enabled ? new BundleBuilder(active->bundle) : nullptr;
+  std::size_t maxPacket = bundler != nullptr ? bundler->capacity() : OUTPUT_BUFFER_SIZE;
+  sender = new OscSender(active->hostname, active->port, active->send, stats, maxPacket);
+  pacer = active->pacing.enabled ? new Pacer(sender, active->pacing, maxPacket) : nullptr;
 }
 
 MyoOscGenerator::~MyoOscGenerator() {
-  if (transmitSocket != nullptr) {
-    delete transmitSocket;
+  if (bundler != nullptr) {
+    delete bundler;
+  }
+  if (pacer != nullptr) {
+    delete pacer;
+  }
+  if (sender != nullptr) {
+    delete sender;
+  }
+}
+
+void MyoOscGenerator::prefault() {
+  std::memset(buffer, 0, sizeof(buffer));
+  if (bundler != nullptr)
+    bundler->prefault();
+  sender->prefault();
+  if (pacer != nullptr)
+    pacer->prefault();
+}
+
+bool MyoOscGenerator::filter(FilterBank& bank, const OutputType& type, float* samples) {
+  if (type.biquads.empty())
+    return false;
+  // a reload with different filters starts from a clean state
+  if (bank.differs(type.biquads))
+    bank.configure(type.biquads);
+  bank.process(samples);
+  return true;
+}
+
+myo::Vector3<float> MyoOscGenerator::filter(FilterBank& bank, const OutputType& type,
+                                            const myo::Vector3<float>& vec) {
+  float samples[3] = { vec.x(), vec.y(), vec.z() };
+  if (!filter(bank, type, samples))
+    return vec;
+  return myo::Vector3<float>(samples[0], samples[1], samples[2]);
+}
+
+bool MyoOscGenerator::detectGestures(const Settings& settings) {
+  if (!settings.gesture || settings.gestures.model.classes.empty())
+    return false;
+  if (gestures.differs(settings.gestures))
+    gestures.configure(settings.gestures);
+  stats->countEvent(OutputId::GESTURE);
+  return true;
+}
+
+void MyoOscGenerator::resample(const Settings& settings, FrameStream stream,
+                               uint64_t timestamp, const float* values) {
+  if (!settings.frame || !settings.frames.includes(stream))
+    return;
+  stats->countEvent(OutputId::FRAME);
+  if (resampler.differs(settings.frames)) {
+    // the batch's frames were for the old rate and streams
+    sendFrameBatch(settings.frame);
+    resampler.configure(settings.frames);
+  }
+  resampler.add(stream, timestamp, values);
+  float frame[RESAMPLE_MAX_FRAME];
+  uint64_t frameTime;
+  while (int count = resampler.next(&frameTime, frame)) {
+    if (settings.frames.format == FrameFormat::ARRAYS) {
+      batchFrame(settings, frameTime, frame, count);
+    } else {
+      sendFrameBatch(settings.frame);
+      sendFrame(settings.frame, frameTime, frame, count);
+    }
+  }
+}
+
+// a message of frames arrays: the count and timestamp, then a [f...] per frame
+static std::size_t frameBatchSize(const OutputType& type, int frames, int width) {
+  return bundledMessageSize(type.path.size(), 2 + frames * (width + 2), 12 + frames * width * 4);
+}
+
+void MyoOscGenerator::batchFrame(const Settings& settings, uint64_t timestamp, const float* vals, int count) {
+  // the largest message beginPacket() always has room for
+  static const std::size_t roomy = OUTPUT_BUFFER_SIZE - BUNDLE_HEADER_SIZE;
+  if (batchedFrames > 0 &&
+      (count != batchWidth || frameBatchSize(settings.frame, batchedFrames + 1, count) > roomy))
+    sendFrameBatch(settings.frame);
+  if (batchedFrames == 0) {
+    batchTime = timestamp;
+    batchWidth = count;
   }
+  std::copy(vals, vals + count, frameBatch + batchedFrames * count);
+  if (++batchedFrames >= settings.frames.batch)
+    sendFrameBatch(settings.frame);
 }
 
-osc::OutboundPacketStream MyoOscGenerator::beginMessage(const std::string& message) {
-  osc::OutboundPacketStream p(buffer, OUTPUT_BUFFER_SIZE);
-  p << osc::BeginMessage(message.c_str());
-  return p;
+void MyoOscGenerator::sendFrameBatch(const OutputType& type) {
+  if (batchedFrames == 0)
+    return;
+  auto& p = beginMessage(type.path, frameBatchSize(type, batchedFrames, batchWidth));
+  p << static_cast<osc::int32>(batchedFrames) << static_cast<osc::int64>(batchTime);
+  for (int i = 0; i < batchedFrames; ++i)
+    p.WriteFloatArray(frameBatch + i * batchWidth, batchWidth);
+  send(type, p << osc::EndMessage);
+  if (active->logOsc) {
+    logPath(type.path);
+    std::cout << "  " << batchedFrames << " " << batchTime;
+    for (int i = 0; i < batchedFrames * batchWidth; ++i)
+      logVal(frameBatch[i]);
+    std::cout << std::endl;
+  }
+  batchedFrames = 0;
 }
 
-void MyoOscGenerator::send(const osc::OutboundPacketStream& p) {
-  transmitSocket->Send(p.Data(), p.Size());
+osc::OutboundPacketStream& MyoOscGenerator::beginPacket(std::size_t messageSize) {
+  // immediately, unless time tags are on
+  uint64_t timeTag = active->timeTags.enabled ? clock.toTimeTag(eventTime) : 1;
+  if (bundler != nullptr) {
+    if (!bundler->fits(messageSize))
+      flush();
+    return bundler->begin(eventTime, timeTag);
+  }
+  packet.Clear();
+  if (active->timeTags.enabled)
+    packet << osc::BeginBundle(timeTag);
+  return packet;
 }
 
+osc::OutboundPacketStream& MyoOscGenerator::beginMessage(const std::string& message, std::size_t messageSize) {
+  return beginPacket(messageSize) << osc::BeginMessage(message.c_str());
+}
+
+void MyoOscGenerator::send(const OutputType& type, osc::OutboundPacketStream& p) {
+  if (!p.IsOk()) {
+    // a message too big for the buffer. when bundling, only it is taken
+    // back, the messages before it are still sent
+    sender->drop(type.id);
+    if (bundler != nullptr)
+      bundler->rollback();
+    return;
+  }
+  if (bundler != nullptr) {
+    stats->countMessage(type.id, bundler->added(type.id, type.priority));
+    return;
+  }
+  if (p.IsBundleInProgress())
+    p << osc::EndBundle;
+  stats->countMessage(type.id, p.Size());
+  transmit(p.Data(), p.Size(), type.id, type.priority, eventTime);
+}
+
+void MyoOscGenerator::flush() {
+  if (bundler == nullptr || bundler->empty())
+    return;
+  std::size_t size = bundler->finish();
+  transmit(bundler->data(), size, bundler->id(), bundler->priority(), bundler->eventTime());
+}
+
+void MyoOscGenerator::transmit(const char* data, std::size_t size, OutputId id, Priority priority,
+                               uint64_t time) {
+  if (pacer != nullptr) {
+    int64_t due = clock.toHost(time) + static_cast<int64_t>(active->pacing.delay * 1000);
+    pacer->schedule(due, data, size, id, priority);
+    return;
+  }
+  // straight from the message buffer or the bundle, without a copy
+  sender->send(data, size, id, priority);
+}
+
+// what the accelerometer reads at rest, in the world frame, units of g
+static const myo::Vector3<float> GRAVITY(0, 0, 1);
+
 // units of g
 void MyoOscGenerator::onAccelerometerData(myo::Myo* myo, uint64_t timestamp, const myo::Vector3<float>& accel)
 {
+  stats->countEvent(OutputId::ACCEL);
+  const Settings& settings = current(timestamp);
+  if (detectGestures(settings))
+    gestures.addAccel(accel);
+  {
+    float values[3] = { accel.x(), accel.y(), accel.z() };
+    resample(settings, FrameStream::ACCEL, timestamp, values);
+  }
+  if (settings.worldAccel)
+    stats->countEvent(OutputId::WORLD_ACCEL);
+  if (settings.linearAccel)
+    stats->countEvent(OutputId::LINEAR_ACCEL);
+  if ((settings.worldAccel || settings.linearAccel) &&
+      haveRotation && timestamp == rotationTimestamp) {
+    myo::Vector3<float> world = rotation.apply(accel);
+    if (settings.worldAccel)
+      sendMessage(settings.worldAccel, world);
+    if (settings.linearAccel)
+      sendMessage(settings.linearAccel, myo::Vector3<float>(world.x() - GRAVITY.x(),
+                                                            world.y() - GRAVITY.y(),
+                                                            world.z() - GRAVITY.z()));
+  }
   if (!settings.accel)
     return;
-  sendMessage(settings.accel, accel);
+  sendMessage(settings.accel, filter(accelFilter, settings.accel, accel));
 }
 
 // units of deg/s
 void MyoOscGenerator::onGyroscopeData(myo::Myo* myo, uint64_t timestamp, const myo::Vector3<float>& gyro)
 {
-  if (!settings.gyro)
-    return;
-  sendMessage(settings.gyro, gyro);
-}
-
-static myo::Vector3<float> quaternionToVector(const myo::Quaternion<float>& quat) {
-  // Calculate Euler angles (roll, pitch, and yaw) from the unit quaternion.
-  float yaw = atan2(2.0f * (quat.w() * quat.z() + quat.x() * quat.y()),
-                    1.0f - 2.0f * (quat.y() * quat.y() + quat.z() * quat.z()));
-  float pitch = asin(2.0f * (quat.w() * quat.y() - quat.z() * quat.x()));
-  float roll = atan2(2.0f * (quat.w() * quat.x() + quat.y() * quat.z()),
-                     1.0f - 2.0f * (quat.x() * quat.x() + quat.y() * quat.y()));
-  return myo::Vector3<float>(yaw, pitch, roll);
+  stats->countEvent(OutputId::GYRO);
+  const Settings& settings = current(timestamp);
+  if (detectGestures(settings))
+    gestures.addGyro(gyro);
+  {
+    float values[3] = { gyro.x(), gyro.y(), gyro.z() };
+    resample(settings, FrameStream::GYRO, timestamp, values);
+  }
+  if (orientationPending) {
+    orientationPending = false;
+    if (timestamp == pendingTimestamp)
+      sendOrientation(settings, predictOrientation(pendingOrientation, gyro,
+                                                   settings.orientationFilter.predict));
+  }
+  if (settings.worldGyro) {
+    stats->countEvent(OutputId::WORLD_GYRO);
+    if (haveRotation && timestamp == rotationTimestamp)
+      sendMessage(settings.worldGyro, rotation.apply(gyro));
+  }
+  if (settings.gyro)
+    sendMessage(settings.gyro, filter(gyroFilter, settings.gyro, gyro));
+  // the last of libmyo's three callbacks for an IMU event
+  flush();
 }
 
 // onOrientationData() is called whenever the Myo device provides its current orientation, which is represented
 // as a unit quaternion.
 void MyoOscGenerator::onOrientationData(myo::Myo* myo, uint64_t timestamp, const myo::Quaternion<float>& quat)
 {
+  // one libmyo orientation event also produces the accel and gyro callbacks
+  stats->countMyoEvent(myo);
+  stats->countEvent(OutputId::ORIENTATION);
+  const Settings& settings = current(timestamp);
+  if (settings.orientationQuat)
+    stats->countEvent(OutputId::ORIENTATION_QUAT);
+  myo::Quaternion<float> calibrated = calibration.apply(quat, settings.calibration.yawOnly);
+  {
+    float values[4] = { calibrated.x(), calibrated.y(), calibrated.z(), calibrated.w() };
+    resample(settings, FrameStream::ORIENTATION, timestamp, values);
+  }
+  if (settings.worldAccel || settings.linearAccel || settings.worldGyro) {
+    // only the heading of the reference, a tilted one would move gravity
+    // off +z
+    rotation = Rotation(calibration.headingInverse() * quat);
+    rotationTimestamp = timestamp;
+    haveRotation = true;
+  }
   if (!settings.orientation && !settings.orientationQuat)
     return;
   
+  myo::Quaternion<float> smoothed = orientationFilter.smooth(settings.orientationFilter, calibrated, timestamp);
+  if (settings.orientationFilter.predict > 0) {
+    // libmyo follows this with onAccelerometerData and onGyroscopeData for the same
+    // timestamp, the prediction is finished and sent there
+    orientationPending = true;
+    pendingOrientation = smoothed;
+    pendingTimestamp = timestamp;
+    return;
+  }
+  sendOrientation(settings, smoothed);
+}
+
+void MyoOscGenerator::sendOrientation(const Settings& settings, const myo::Quaternion<float>& quat) {
   if (settings.orientationQuat)
     sendMessage(settings.orientationQuat, quat);
   
   if (settings.orientation) {
-    auto ypr = quaternionToVector(quat);
-    sendMessage(settings.orientation, ypr);
+    if (euler.differs(settings.euler, settings.orientation))
+      euler.configure(settings.euler, settings.orientation);
+    unsigned clamps = 0;
+    auto angles = euler.convert(quat, &clamps);
+    stats->countClamps(settings.orientation.id, clamps);
+    sendVector(settings.orientation, angles);
   }
 }
 
@@ -243,10 +616,14 @@ void MyoOscGenerator::onOrientationData(myo::Myo* myo, uint64_t timestamp, const
 // making a fist, or not making a fist anymore.
 void MyoOscGenerator::onPose(myo::Myo* myo, uint64_t timestamp, myo::Pose pose)
 {
+  stats->countMyoEvent(myo);
+  stats->countEvent(OutputId::POSE);
+  const Settings& settings = current(timestamp);
   if (!settings.pose)
     return;
   
   sendMessage(settings.pose, pose.toString().c_str());
+  flush();
   
   // Vibrate the Myo whenever we've detected that the user has made a fist.
   if (pose == myo::Pose::fist) {
@@ -255,24 +632,78 @@ void MyoOscGenerator::onPose(myo::Myo* myo, uint64_t timestamp, myo::Pose pose)
 }
 
 void MyoOscGenerator::onRssi(myo::Myo *myo, uint64_t timestamp, int8_t rssi) {
-  if (!settings.rssi)
-    return;
-  sendMessage(settings.rssi, rssi);
+  stats->countMyoEvent(myo);
+  stats->countEvent(OutputId::RSSI);
+  const Settings& settings = current(timestamp);
+  {
+    float value = rssi;
+    resample(settings, FrameStream::RSSI, timestamp, &value);
+  }
+  if (settings.rssi)
+    sendMessage(settings.rssi, rssi);
+  flush();
 }
 
 void MyoOscGenerator::onEmgData(myo::Myo* myo, uint64_t timestamp, const int8_t* emg) {
-  if (!settings.emg)
-    return;
-  sendMessage(settings.emg, emg, 8);
+  stats->countMyoEvent(myo);
+  stats->countEvent(OutputId::EMG);
+  const Settings& settings = current(timestamp);
+  {
+    float values[EMG_CHANNELS];
+    std::copy(emg, emg + EMG_CHANNELS, values);
+    resample(settings, FrameStream::EMG, timestamp, values);
+  }
+  if (settings.emg) {
+    // filtered EMG goes out as floats
+    float samples[EMG_CHANNELS];
+    std::copy(emg, emg + EMG_CHANNELS, samples);
+    if (filter(emgFilter, settings.emg, samples))
+      sendMessage(settings.emg, samples, EMG_CHANNELS);
+    else
+      sendMessage(settings.emg, emg, EMG_CHANNELS);
+  }
+  
+  if (settings.emgEnvelope) {
+    stats->countEvent(OutputId::EMG_ENVELOPE);
+    // a reload with a new window or cutoff starts the envelope over
+    if (envelope.differs(settings.envelope))
+      envelope.configure(settings.envelope);
+    envelope.process(emg);
+    float vals[EMG_CHANNELS * 2];
+    std::memcpy(vals, envelope.rms(), sizeof(float) * EMG_CHANNELS);
+    std::memcpy(vals + EMG_CHANNELS, envelope.envelope(), sizeof(float) * EMG_CHANNELS);
+    sendMessage(settings.emgEnvelope, vals, EMG_CHANNELS * 2);
+  }
+  
+  if (settings.emgBands) {
+    stats->countEvent(OutputId::EMG_BANDS);
+    if (bands.differs(settings.bands))
+      bands.configure(settings.bands);
+    if (bands.process(emg))
+      sendMessage(settings.emgBands, bands.powers(), bands.count());
+  }
+  
+  if (detectGestures(settings) && gestures.addEmg(emg)) {
+    sendGesture(settings.gesture, gestures.gesture(), gestures.score());
+    if (settings.gestures.vibrate)
+      myo->vibrate(myo::Myo::vibrationShort);
+  }
+  flush();
 }
 
 // onArmSync() is called whenever Myo has recognized a setup gesture after someone has put it on their
 // arm. This lets Myo know which arm it's on and which way it's facing.
 void MyoOscGenerator::onArmSync(myo::Myo* myo, uint64_t timestamp, myo::Arm arm, myo::XDirection xDirection)
 {
+  stats->countMyoEvent(myo);
+  stats->countEvent(OutputId::SYNC);
+  const Settings& settings = current(timestamp);
+  if (settings.calibration.onSync)
+    calibration.requestCapture();
   if (!settings.sync)
     return;
   sendMessage(settings.sync, (arm == myo::armLeft ? "L" : "R"));
+  flush();
 }
 
 // onArmUnsync() is called whenever Myo has detected that it was moved from a stable position on a person's arm after
@@ -280,7 +711,11 @@ void MyoOscGenerator::onArmSync(myo::Myo* myo, uint64_t timestamp, myo::Arm arm,
 // when Myo is moved around on the arm.
 void MyoOscGenerator::onArmUnsync(myo::Myo* myo, uint64_t timestamp)
 {
+  stats->countMyoEvent(myo);
+  stats->countEvent(OutputId::SYNC);
+  const Settings& settings = current(timestamp);
   if (!settings.sync)
     return;
   sendMessage(settings.sync, "-");
+  flush();
 }
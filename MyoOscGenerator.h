@@ -11,6 +11,7 @@
 // Distributed under the Myo SDK license agreement. See LICENSE.txt for details.
 
 #ifndef __MYO_OSC_GENERATOR_H__
+#define __MYO_OSC_GENERATOR_H__
 
 // stop oscpack sprintf warnings
 #ifdef _MSC_VER
@@ -24,21 +25,38 @@
 
 // add oscpack
 #include "osc/OscOutboundPacketStream.h"
-#include "ip/UdpSocket.h"
-
-#define OUTPUT_BUFFER_SIZE 1024
 
+#include "MyoOscBundle.h"
+#include "MyoOscClock.h"
+#include "MyoOscConfig.h"
+#include "MyoOscEmg.h"
+#include "MyoOscFilter.h"
+#include "MyoOscGesture.h"
+#include "MyoOscOrientation.h"
+#include "MyoOscPacer.h"
+#include "MyoOscResample.h"
 #include "MyoOscSettings.h"
+#include "MyoOscSender.h"
+#include "MyoOscStats.h"
 
 // Classes that inherit from myo::DeviceListener can be used to receive events from Myo devices. DeviceListener
 // provides several virtual functions for handling different kinds of events. If you do not override an event, the
 // default behavior is to do nothing.
 class MyoOscGenerator : public myo::DeviceListener {
 public:
-  explicit MyoOscGenerator(Settings settings);
+  // the sender is set up from the initial snapshot, everything else follows
+  // the current one
+  MyoOscGenerator(SettingsHolder* config, Stats* stats);
   
   ~MyoOscGenerator() override;
   
+  // touches the message buffer and send queue ahead of the first event
+  void prefault();
+  
+  // sends the open bundle, if bundling is on. call on the hub thread
+  // between hub runs, so nothing waits longer than a slice.
+  void flush();
+  
   // units of g
   void onAccelerometerData(myo::Myo* myo, uint64_t timestamp, const myo::Vector3<float>& accel) override;
 
@@ -69,20 +87,121 @@ public:
   // when Myo is moved around on the arm.
   void onArmUnsync(myo::Myo* myo, uint64_t timestamp) override;
   
-  osc::OutboundPacketStream beginMessage(const std::string& message);
+  // the stream to write one message of messageSize bytes (see
+  // bundledMessageSize) to, with a bundle time-tagged for the current event
+  // already open if time tags are on. with bundling on it's the shared
+  // bundle, sent first if the message won't fit. fixed-shape messages are
+  // written with WriteMessage(), which needs no type tag rewrite.
+  osc::OutboundPacketStream& beginPacket(std::size_t messageSize);
+  
+  // beginPacket() followed by BeginMessage, for messages built up an
+  // argument at a time
+  osc::OutboundPacketStream& beginMessage(const std::string& message, std::size_t messageSize);
   
-  void send(const osc::OutboundPacketStream& p);
+  // closes the bundle beginPacket() opened, if any, and sends it. with
+  // bundling on the message just stays in the shared bundle.
+  void send(const OutputType& type, osc::OutboundPacketStream& p);
+  
+  // hands a finished datagram to the pacer or the sender
+  void transmit(const char* data, std::size_t size, OutputId id, Priority priority, uint64_t time);
   
   void sendMessage(const OutputType& type, int8_t val);
   void sendMessage(const OutputType& type, const int8_t* vals, int count);
+  void sendMessage(const OutputType& type, const float* vals, int count);
   void sendMessage(const OutputType& type, const char* val);
   void sendMessage(const OutputType& type, myo::Vector3<float> vec);
+  // sends vec as it is, for values already scaled for the output
+  void sendVector(const OutputType& type, const myo::Vector3<float>& vec);
   void sendMessage(const OutputType& type, myo::Vector3<float> vec1, myo::Vector3<float> vec2);
   void sendMessage(const OutputType& type, myo::Quaternion<float> quat);
+  // sends already scaled values as one blob in the type's half or int16
+  // encoding, count at most COMPACT_MAX_VALUES
+  void sendCompact(const OutputType& type, const float* vals, int count);
+  
+  // sends a recognized gesture's name and its classifier distance or score
+  void sendGesture(const OutputType& type, const std::string& name, float score);
+  
+  // sends one resampled frame, its libmyo timestamp followed by the values
+  void sendFrame(const OutputType& type, uint64_t timestamp, const float* vals, int count);
+  
+  // adds a frame to the batch for the arrays format, sending the batch
+  // once it's full or another frame wouldn't fit
+  void batchFrame(const Settings& settings, uint64_t timestamp, const float* vals, int count);
+  // sends the batched frames, if any, as one message of arrays
+  void sendFrameBatch(const OutputType& type);
+  
+  // feeds a sample to the frame output, if it includes the stream, and
+  // sends any frames that have come due
+  void resample(const Settings& settings, FrameStream stream, uint64_t timestamp, const float* values);
+  
+  // sends the orientation and orientationQuat outputs for quat
+  void sendOrientation(const Settings& settings, const myo::Quaternion<float>& quat);
+  
+  // runs the output's filter cascade, if it has one, over samples in place.
+  // returns false if there's nothing to do.
+  bool filter(FilterBank& bank, const OutputType& type, float* samples);
+  myo::Vector3<float> filter(FilterBank& bank, const OutputType& type, const myo::Vector3<float>& vec);
+  
+  // true if the gesture output is on and has a model, reconfiguring the
+  // engine after a reload. counts an input event for the gesture output.
+  bool detectGestures(const Settings& settings);
+  
+  // loads the current settings snapshot for the rest of this callback, and
+  // notes the event's libmyo timestamp for time tags
+  const Settings& current(uint64_t timestamp) {
+    active = config->get();
+    // a bundle carries one event's time tag
+    if (bundler != nullptr && timestamp != bundler->eventTime())
+      flush();
+    eventTime = timestamp;
+    if (active->timeTags.enabled || pacer != nullptr) {
+      if (clock.differs(active->timeTags))
+        clock.configure(active->timeTags);
+      clock.observe(timestamp);
+    }
+    return *active;
+  }
   
   char buffer[OUTPUT_BUFFER_SIZE];
-  UdpTransmitSocket* transmitSocket;
-  Settings settings;
+  // over buffer, rewritten for each unbundled message
+  osc::OutboundPacketStream packet;
+  // set if bundling is on, messages then collect there instead
+  BundleBuilder* bundler;
+  OscSender* sender;
+  // set if pacing is on, packets then go through it to the sender
+  Pacer* pacer;
+  SettingsHolder* config;
+  const Settings* active;
+  // maps libmyo timestamps to wall-clock time tags
+  ClockTranslator clock;
+  uint64_t eventTime;
+  Stats* stats;
+  EmgEnvelope envelope;
+  EmgBands bands;
+  GestureEngine gestures;
+  Resampler resampler;
+  // frames waiting to go out together in the arrays format
+  float frameBatch[FRAME_MAX_BATCH * RESAMPLE_MAX_FRAME];
+  int batchedFrames;
+  int batchWidth;
+  uint64_t batchTime;
+  FilterBank accelFilter;
+  FilterBank gyroFilter;
+  FilterBank emgFilter;
+  OrientationFilter orientationFilter;
+  // reference orientation, updated from the control channel or on arm sync
+  Calibration calibration;
+  EulerConverter euler;
+  // with prediction on, the smoothed orientation waits here for the gyro
+  // callback that libmyo makes for the same event
+  bool orientationPending;
+  myo::Quaternion<float> pendingOrientation;
+  uint64_t pendingTimestamp;
+  // rotation from the latest orientation event, for the world-frame outputs
+  // derived from the accel and gyro callbacks with the same timestamp
+  Rotation rotation;
+  uint64_t rotationTimestamp;
+  bool haveRotation;
 };
 
 #endif // __MYO_OSC_GENERATOR_H__
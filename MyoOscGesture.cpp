@@ -0,0 +1,303 @@
+// MyoOscGesture.cpp
+
+#include "MyoOscGesture.h"
+#include "MyoOscEmg.h"
+
+#include "picojson.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+static_assert(GESTURE_EMG_CHANNELS == EMG_CHANNELS, "gesture features assume one per EMG channel");
+
+// IMU samples per second
+#define GESTURE_IMU_RATE 50
+
+GestureModel::GestureModel()
+: classifier(GestureClassifier::CENTROID)
+, threshold(std::numeric_limits<float>::infinity())
+, version(0) {
+  for (int i = 0; i < GESTURE_FEATURES; ++i) {
+    mean[i] = 0;
+    invScale[i] = 1;
+  }
+}
+
+static void readFeatures(const picojson::value& val, const char* what, float* out) {
+  if (!val.is<picojson::array>() || val.get<picojson::array>().size() != GESTURE_FEATURES)
+    throw std::invalid_argument(std::string("Gesture model ") + what + " must be an array of " +
+                                std::to_string(GESTURE_FEATURES) + " numbers");
+  const auto& arr = val.get<picojson::array>();
+  for (int i = 0; i < GESTURE_FEATURES; ++i) {
+    if (!arr[i].is<double>())
+      throw std::invalid_argument(std::string("Invalid number in gesture model ") + what + ": " +
+                                  arr[i].serialize());
+    out[i] = static_cast<float>(arr[i].get<double>());
+  }
+}
+
+void loadGestureModel(const std::string& filename, GestureModel* model) {
+  static std::atomic<unsigned> versions(0);
+
+  std::ifstream in(filename);
+  if (!in.good())
+    throw std::invalid_argument("Unable to read gesture model " + filename);
+  picojson::value root;
+  std::string err = picojson::parse(root, in);
+  if (!err.empty())
+    throw std::invalid_argument("Error parsing gesture model " + filename + ": " + err);
+  if (!root.is<picojson::object>())
+    throw std::invalid_argument("Invalid gesture model " + filename);
+
+  GestureModel loaded;
+  const picojson::value& classifier = root.get("classifier");
+  if (classifier.is<std::string>() && classifier.get<std::string>() == "linear")
+    loaded.classifier = GestureClassifier::LINEAR;
+  else if (classifier.is<std::string>() && classifier.get<std::string>() == "centroid")
+    loaded.classifier = GestureClassifier::CENTROID;
+  else if (!classifier.is<picojson::null>())
+    throw std::invalid_argument("Invalid gesture classifier: " + classifier.serialize());
+  if (loaded.classifier == GestureClassifier::LINEAR)
+    loaded.threshold = -std::numeric_limits<float>::infinity();
+
+  if (!root.get("mean").is<picojson::null>())
+    readFeatures(root.get("mean"), "mean", loaded.mean);
+  if (!root.get("scale").is<picojson::null>()) {
+    float scale[GESTURE_FEATURES];
+    readFeatures(root.get("scale"), "scale", scale);
+    for (int i = 0; i < GESTURE_FEATURES; ++i) {
+      if (!(scale[i] > 0))
+        throw std::invalid_argument("Gesture model scale values must be positive");
+      loaded.invScale[i] = 1.0f / scale[i];
+    }
+  }
+  const picojson::value& threshold = root.get("threshold");
+  if (threshold.is<double>())
+    loaded.threshold = static_cast<float>(threshold.get<double>());
+  else if (!threshold.is<picojson::null>())
+    throw std::invalid_argument("Invalid gesture threshold: " + threshold.serialize());
+  std::string rest;
+  if (root.get("rest").is<std::string>())
+    rest = root.get("rest").get<std::string>();
+
+  const picojson::value& classes = root.get("classes");
+  if (!classes.is<picojson::array>() || classes.get<picojson::array>().empty())
+    throw std::invalid_argument("Gesture model " + filename + " has no classes");
+  const char* key = loaded.classifier == GestureClassifier::LINEAR ? "weights" : "centroid";
+  for (const auto& classval : classes.get<picojson::array>()) {
+    GestureClass gesture;
+    if (!classval.is<picojson::object>() || !classval.get("name").is<std::string>())
+      throw std::invalid_argument("Invalid gesture class: " + classval.serialize());
+    gesture.name = classval.get("name").get<std::string>();
+    readFeatures(classval.get(key), key, gesture.values);
+    gesture.bias = 0;
+    if (classval.get("bias").is<double>())
+      gesture.bias = static_cast<float>(classval.get("bias").get<double>());
+    gesture.rest = gesture.name == rest;
+    loaded.classes.push_back(gesture);
+  }
+  loaded.version = ++versions;
+  *model = loaded;
+}
+
+std::ostream& operator<<(std::ostream& os, const GestureSettings& gestures) {
+  if (gestures.model.classes.empty())
+    os << "no model";
+  else
+    os << gestures.modelFile << " ("
+    << (gestures.model.classifier == GestureClassifier::LINEAR ? "linear" : "centroid")
+    << ", " << gestures.model.classes.size() << " classes)";
+  os << ", window " << gestures.window << "ms, hop " << gestures.hop << "ms, hold " << gestures.hold;
+  if (gestures.vibrate)
+    os << ", vibrate";
+  return os;
+}
+
+GestureEngine::GestureEngine()
+: window_(0), hop_(0), hold_(0)
+, emgWindow_(0), emgPos_(0), emgFilled_(0), havePrevious_(false)
+, imuWindow_(0), accelPos_(0), accelFilled_(0), gyroPos_(0), gyroFilled_(0)
+, hopSamples_(1), sinceHop_(0)
+, candidate_(-1), candidateHops_(0), current_(-1), score_(0) {
+  configure(GestureSettings());
+}
+
+void GestureEngine::configure(const GestureSettings& settings) {
+  model_ = settings.model;
+  window_ = settings.window;
+  hop_ = settings.hop;
+  hold_ = settings.hold;
+
+  emgWindow_ = std::max(1, static_cast<int>(window_ * EMG_SAMPLE_RATE / 1000));
+  imuWindow_ = std::max(2, window_ * GESTURE_IMU_RATE / 1000);
+  hopSamples_ = std::max(1, static_cast<int>(hop_ * EMG_SAMPLE_RATE / 1000));
+  emgAbs_.assign(emgWindow_ * GESTURE_EMG_CHANNELS, 0);
+  emgDiff_.assign(emgWindow_ * GESTURE_EMG_CHANNELS, 0);
+  accel_.assign(imuWindow_ * 3, 0);
+  gyro_.assign(imuWindow_ * 3, 0);
+  emgPos_ = emgFilled_ = 0;
+  accelPos_ = accelFilled_ = 0;
+  gyroPos_ = gyroFilled_ = 0;
+  havePrevious_ = false;
+  for (int c = 0; c < GESTURE_EMG_CHANNELS; ++c) {
+    absSums_[c] = 0;
+    diffSums_[c] = 0;
+    previous_[c] = 0;
+  }
+  for (int i = 0; i < 3; ++i) {
+    accelSums_[i] = 0;
+    accelSquares_[i] = 0;
+    gyroSums_[i] = 0;
+  }
+  sinceHop_ = 0;
+  candidate_ = -1;
+  candidateHops_ = 0;
+  current_ = -1;
+  score_ = 0;
+  std::fill(features_, features_ + GESTURE_FEATURES, 0.0f);
+}
+
+void GestureEngine::addAccel(const myo::Vector3<float>& accel) {
+  float* row = &accel_[accelPos_ * 3];
+  for (int i = 0; i < 3; ++i) {
+    float x = accel[i];
+    accelSums_[i] += x - row[i];
+    accelSquares_[i] += x * x - row[i] * row[i];
+    row[i] = x;
+  }
+  if (accelFilled_ < imuWindow_)
+    ++accelFilled_;
+  if (++accelPos_ == imuWindow_) {
+    accelPos_ = 0;
+    for (int i = 0; i < 3; ++i) {
+      accelSums_[i] = 0;
+      accelSquares_[i] = 0;
+    }
+    for (int r = 0; r < imuWindow_; ++r) {
+      for (int i = 0; i < 3; ++i) {
+        float x = accel_[r * 3 + i];
+        accelSums_[i] += x;
+        accelSquares_[i] += x * x;
+      }
+    }
+  }
+}
+
+void GestureEngine::addGyro(const myo::Vector3<float>& gyro) {
+  float* row = &gyro_[gyroPos_ * 3];
+  for (int i = 0; i < 3; ++i) {
+    float x = std::fabs(gyro[i]);
+    gyroSums_[i] += x - row[i];
+    row[i] = x;
+  }
+  if (gyroFilled_ < imuWindow_)
+    ++gyroFilled_;
+  if (++gyroPos_ == imuWindow_) {
+    gyroPos_ = 0;
+    for (int i = 0; i < 3; ++i)
+      gyroSums_[i] = 0;
+    for (int r = 0; r < imuWindow_; ++r) {
+      for (int i = 0; i < 3; ++i)
+        gyroSums_[i] += gyro_[r * 3 + i];
+    }
+  }
+}
+
+bool GestureEngine::addEmg(const int8_t* emg) {
+  int16_t* absRow = &emgAbs_[emgPos_ * GESTURE_EMG_CHANNELS];
+  int16_t* diffRow = &emgDiff_[emgPos_ * GESTURE_EMG_CHANNELS];
+  for (int c = 0; c < GESTURE_EMG_CHANNELS; ++c) {
+    int16_t x = emg[c];
+    int16_t a = static_cast<int16_t>(std::abs(x));
+    int16_t d = havePrevious_ ? static_cast<int16_t>(std::abs(x - previous_[c])) : 0;
+    absSums_[c] += a - absRow[c];
+    diffSums_[c] += d - diffRow[c];
+    absRow[c] = a;
+    diffRow[c] = d;
+    previous_[c] = emg[c];
+  }
+  havePrevious_ = true;
+  if (emgFilled_ < emgWindow_)
+    ++emgFilled_;
+  if (++emgPos_ == emgWindow_)
+    emgPos_ = 0;
+
+  if (++sinceHop_ < hopSamples_)
+    return false;
+  sinceHop_ = 0;
+  if (model_.classes.empty() || emgFilled_ < emgWindow_ ||
+      accelFilled_ < imuWindow_ || gyroFilled_ < imuWindow_)
+    return false;
+
+  computeFeatures();
+  int best = classify(&score_);
+  if (best >= 0 && model_.classes[best].rest)
+    best = -1;
+  // a class has to win hold_ hops in a row before it replaces the current one
+  if (best != candidate_) {
+    candidate_ = best;
+    candidateHops_ = 0;
+  }
+  if (candidateHops_ < hold_)
+    ++candidateHops_;
+  if (candidateHops_ < hold_ || candidate_ == current_)
+    return false;
+  current_ = candidate_;
+  return current_ >= 0;
+}
+
+void GestureEngine::computeFeatures() {
+  float emgScale = 1.0f / emgWindow_;
+  for (int c = 0; c < GESTURE_EMG_CHANNELS; ++c) {
+    features_[c] = absSums_[c] * emgScale;
+    features_[GESTURE_EMG_CHANNELS + c] = diffSums_[c] * emgScale;
+  }
+  double imuScale = 1.0 / imuWindow_;
+  float* imu = features_ + GESTURE_EMG_CHANNELS * 2;
+  for (int i = 0; i < 3; ++i) {
+    double mean = accelSums_[i] * imuScale;
+    double variance = accelSquares_[i] * imuScale - mean * mean;
+    imu[i] = static_cast<float>(std::sqrt(std::max(0.0, variance)));
+    imu[3 + i] = static_cast<float>(gyroSums_[i] * imuScale);
+  }
+}
+
+int GestureEngine::classify(float* score) const {
+  float z[GESTURE_FEATURES];
+  for (int i = 0; i < GESTURE_FEATURES; ++i)
+    z[i] = (features_[i] - model_.mean[i]) * model_.invScale[i];
+
+  int best = -1;
+  float bestScore = 0;
+  for (std::size_t k = 0; k < model_.classes.size(); ++k) {
+    const float* values = model_.classes[k].values;
+    float s = model_.classes[k].bias;
+    if (model_.classifier == GestureClassifier::CENTROID) {
+      for (int i = 0; i < GESTURE_FEATURES; ++i) {
+        float d = z[i] - values[i];
+        s += d * d;
+      }
+      if (best < 0 || s < bestScore) {
+        best = static_cast<int>(k);
+        bestScore = s;
+      }
+    } else {
+      for (int i = 0; i < GESTURE_FEATURES; ++i)
+        s += z[i] * values[i];
+      if (best < 0 || s > bestScore) {
+        best = static_cast<int>(k);
+        bestScore = s;
+      }
+    }
+  }
+  *score = bestScore;
+  if (model_.classifier == GestureClassifier::CENTROID ? bestScore > model_.threshold
+      : bestScore < model_.threshold)
+    return -1;
+  return best;
+}
@@ -0,0 +1,148 @@
+// MyoOscGesture.h
+//
+// Custom gesture detection on top of the EMG and IMU streams. Features are
+// kept up to date one sample at a time from running sums over fixed-size
+// rings, and every hop the feature vector is matched against a small model
+// loaded from a JSON file: the nearest class centroid, or the best of a set
+// of linear discriminants. Either way a hop costs classes * GESTURE_FEATURES
+// multiply-adds, so detection is cheap enough to run inside the callbacks.
+
+#ifndef __MYO_OSC_GESTURE_H__
+#define __MYO_OSC_GESTURE_H__
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <myo/myo.hpp>
+
+#define GESTURE_EMG_CHANNELS 8
+// mean absolute value of each EMG channel, then waveform length (mean
+// absolute difference between samples) of each channel, then the standard
+// deviation of each accel axis and the mean absolute rate of each gyro axis
+#define GESTURE_FEATURES (GESTURE_EMG_CHANNELS * 2 + 6)
+
+enum class GestureClassifier {
+  // smallest squared distance to a class centroid wins
+  CENTROID,
+  // highest weights . features + bias wins
+  LINEAR
+};
+
+struct GestureClass {
+  std::string name;
+  // centroid or weights, in standardized feature units
+  float values[GESTURE_FEATURES];
+  float bias;
+  // matching this class ends a gesture without reporting anything
+  bool rest;
+};
+
+struct GestureModel {
+  GestureClassifier classifier;
+  // features are standardized as (x - mean) * invScale before matching
+  float mean[GESTURE_FEATURES];
+  float invScale[GESTURE_FEATURES];
+  // CENTROID: largest distance accepted, LINEAR: lowest score accepted.
+  // anything else counts as rest.
+  float threshold;
+  std::vector<GestureClass> classes;
+  // different for every model loaded, 0 if none has been
+  unsigned version;
+
+  GestureModel();
+};
+
+// throws std::invalid_argument if the file can't be read or isn't a valid model
+void loadGestureModel(const std::string& filename, GestureModel* model);
+
+// parameters for the gesture output, read from its JSON object
+struct GestureSettings {
+  std::string modelFile;
+  GestureModel model;
+  // feature window and time between classifications, in ms
+  int window;
+  int hop;
+  // consecutive hops a class has to win before it's reported
+  int hold;
+  // give a short vibration for each gesture reported
+  bool vibrate;
+
+  GestureSettings() : window(200), hop(50), hold(2), vibrate(false) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const GestureSettings& gestures);
+
+class GestureEngine {
+public:
+  GestureEngine();
+
+  // true if configure() would change anything
+  bool differs(const GestureSettings& settings) const {
+    return settings.model.version != model_.version || settings.window != window_ ||
+    settings.hop != hop_ || settings.hold != hold_;
+  }
+
+  // copies the model and resets the state; allocates, so only call it when
+  // the settings change
+  void configure(const GestureSettings& settings);
+
+  void addAccel(const myo::Vector3<float>& accel);
+  void addGyro(const myo::Vector3<float>& gyro);
+
+  // returns true when a new gesture has been recognized, see gesture()
+  bool addEmg(const int8_t* emg);
+
+  const std::string& gesture() const { return model_.classes[current_].name; }
+  // distance or score of the last classification
+  float score() const { return score_; }
+  const float* features() const { return features_; }
+
+private:
+  void computeFeatures();
+  // index of the winning class, or -1 if nothing passed the threshold
+  int classify(float* score) const;
+
+  GestureModel model_;
+  int window_;
+  int hop_;
+  int hold_;
+
+  // EMG: |x| and |x - previous x| per channel, emgWindow_ rows. both are
+  // exact in integers, so the running sums never drift.
+  int emgWindow_;
+  int emgPos_;
+  int emgFilled_;
+  std::vector<int16_t> emgAbs_;
+  std::vector<int16_t> emgDiff_;
+  int32_t absSums_[GESTURE_EMG_CHANNELS];
+  int32_t diffSums_[GESTURE_EMG_CHANNELS];
+  int8_t previous_[GESTURE_EMG_CHANNELS];
+  bool havePrevious_;
+
+  // IMU: accel and |gyro|, imuWindow_ rows of 3. the float sums are
+  // recomputed from the ring each time it wraps, to keep rounding from
+  // accumulating.
+  int imuWindow_;
+  int accelPos_;
+  int accelFilled_;
+  int gyroPos_;
+  int gyroFilled_;
+  std::vector<float> accel_;
+  std::vector<float> gyro_;
+  double accelSums_[3];
+  double accelSquares_[3];
+  double gyroSums_[3];
+
+  int hopSamples_;
+  int sinceHop_;
+  int candidate_;
+  int candidateHops_;
+  // class currently reported, -1 for rest
+  int current_;
+  float score_;
+  float features_[GESTURE_FEATURES];
+};
+
+#endif // __MYO_OSC_GESTURE_H__
@@ -0,0 +1,291 @@
+// MyoOscOrientation.cpp
+
+#include "MyoOscOrientation.h"
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// sample interval to assume when timestamps don't help
+#define ORIENTATION_DEFAULT_DT (1.0f / 50)
+
+// rotation matrix of a unit quaternion, m[row][column]
+static void toMatrix(const myo::Quaternion<float>& quat, float m[3][3]) {
+  float x = quat.x(), y = quat.y(), z = quat.z(), w = quat.w();
+  m[0][0] = 1 - 2 * (y * y + z * z);
+  m[0][1] = 2 * (x * y - z * w);
+  m[0][2] = 2 * (x * z + y * w);
+  m[1][0] = 2 * (x * y + z * w);
+  m[1][1] = 1 - 2 * (x * x + z * z);
+  m[1][2] = 2 * (y * z - x * w);
+  m[2][0] = 2 * (x * z - y * w);
+  m[2][1] = 2 * (y * z + x * w);
+  m[2][2] = 1 - 2 * (x * x + y * y);
+}
+
+Rotation::Rotation() {
+  for (int c = 0; c < 3; ++c) {
+    for (int r = 0; r < 4; ++r)
+      columns_[c][r] = c == r ? 1.0f : 0.0f;
+  }
+}
+
+Rotation::Rotation(const myo::Quaternion<float>& quat) {
+  float m[3][3];
+  toMatrix(quat, m);
+  for (int c = 0; c < 3; ++c) {
+    for (int r = 0; r < 3; ++r)
+      columns_[c][r] = m[r][c];
+    columns_[c][3] = 0;
+  }
+}
+
+myo::Vector3<float> Rotation::apply(const myo::Vector3<float>& vec) const {
+  float out[4];
+#if defined(MYO_OSC_SSE)
+  __m128 v = _mm_mul_ps(_mm_loadu_ps(columns_[0]), _mm_set1_ps(vec.x()));
+  v = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(columns_[1]), _mm_set1_ps(vec.y())));
+  v = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(columns_[2]), _mm_set1_ps(vec.z())));
+  _mm_storeu_ps(out, v);
+#elif defined(MYO_OSC_NEON)
+  float32x4_t v = vmulq_n_f32(vld1q_f32(columns_[0]), vec.x());
+  v = vmlaq_n_f32(v, vld1q_f32(columns_[1]), vec.y());
+  v = vmlaq_n_f32(v, vld1q_f32(columns_[2]), vec.z());
+  vst1q_f32(out, v);
+#else
+  for (int r = 0; r < 3; ++r)
+    out[r] = columns_[0][r] * vec.x() + columns_[1][r] * vec.y() + columns_[2][r] * vec.z();
+#endif
+  return myo::Vector3<float>(out[0], out[1], out[2]);
+}
+
+myo::Quaternion<float> slerp(const myo::Quaternion<float>& from,
+                             const myo::Quaternion<float>& to, float t) {
+  float dot = from.x() * to.x() + from.y() * to.y() + from.z() * to.z() + from.w() * to.w();
+  // q and -q are the same rotation, take the short way round
+  float sign = 1;
+  if (dot < 0) {
+    dot = -dot;
+    sign = -1;
+  }
+  float a, b;
+  if (dot > 0.9995f) {
+    // nearly parallel, lerp is accurate and avoids dividing by ~0
+    a = 1 - t;
+    b = t * sign;
+  } else {
+    float theta = std::acos(dot);
+    float sinTheta = std::sin(theta);
+    a = std::sin((1 - t) * theta) / sinTheta;
+    b = std::sin(t * theta) / sinTheta * sign;
+  }
+  return myo::Quaternion<float>(a * from.x() + b * to.x(),
+                                a * from.y() + b * to.y(),
+                                a * from.z() + b * to.z(),
+                                a * from.w() + b * to.w()).normalized();
+}
+
+myo::Quaternion<float> predictOrientation(const myo::Quaternion<float>& quat,
+                                          const myo::Vector3<float>& gyro, float ms) {
+  float toRadians = static_cast<float>(M_PI / 180);
+  myo::Vector3<float> omega(gyro.x() * toRadians, gyro.y() * toRadians, gyro.z() * toRadians);
+  float speed = omega.magnitude();
+  if (speed < 1e-6f)
+    return quat;
+  myo::Vector3<float> axis(omega.x() / speed, omega.y() / speed, omega.z() / speed);
+  // gyro is in the sensor frame, so the extra rotation applies on the right
+  return (quat * myo::Quaternion<float>::fromAxisAngle(axis, speed * ms / 1000)).normalized();
+}
+
+// exponential smoothing factor for a one-pole low-pass at cutoff Hz
+static float smoothingFactor(float cutoff, float dt) {
+  float r = 2 * static_cast<float>(M_PI) * cutoff * dt;
+  return r / (r + 1);
+}
+
+OrientationFilter::OrientationFilter()
+: primed_(false), lastTimestamp_(0), speed_(0) { }
+
+bool OrientationFilter::sameSettings(const OrientationFilterSettings& settings) const {
+  return settings.smoothing == settings_.smoothing &&
+  settings.alpha == settings_.alpha &&
+  settings.minCutoff == settings_.minCutoff &&
+  settings.beta == settings_.beta &&
+  settings.derivativeCutoff == settings_.derivativeCutoff;
+}
+
+myo::Quaternion<float> OrientationFilter::smooth(const OrientationFilterSettings& settings,
+                                                 const myo::Quaternion<float>& quat,
+                                                 uint64_t timestamp) {
+  if (!primed_ || !sameSettings(settings)) {
+    settings_ = settings;
+    primed_ = true;
+    filtered_ = quat;
+    lastTimestamp_ = timestamp;
+    speed_ = 0;
+    return quat;
+  }
+  
+  float dt = timestamp > lastTimestamp_ ? (timestamp - lastTimestamp_) / 1e6f : ORIENTATION_DEFAULT_DT;
+  lastTimestamp_ = timestamp;
+  
+  switch (settings_.smoothing) {
+    case Smoothing::EXPONENTIAL:
+      filtered_ = slerp(filtered_, quat, settings_.alpha);
+      break;
+    case Smoothing::ONE_EURO: {
+      float dot = std::fabs(filtered_.x() * quat.x() + filtered_.y() * quat.y() +
+                            filtered_.z() * quat.z() + filtered_.w() * quat.w());
+      float angle = 2 * std::acos(dot < 1 ? dot : 1);
+      speed_ += smoothingFactor(settings_.derivativeCutoff, dt) * (angle / dt - speed_);
+      float cutoff = settings_.minCutoff + settings_.beta * speed_;
+      filtered_ = slerp(filtered_, quat, smoothingFactor(cutoff, dt));
+      break;
+    }
+    case Smoothing::NONE:
+    default:
+      filtered_ = quat;
+      break;
+  }
+  return filtered_;
+}
+
+Calibration::Calibration()
+: request_(NONE) {
+  for (auto& value : requested_)
+    value = 0;
+}
+
+void Calibration::requestCapture() {
+  request_.store(CAPTURE, std::memory_order_release);
+}
+
+void Calibration::requestReset() {
+  request_.store(RESET, std::memory_order_release);
+}
+
+void Calibration::requestReference(const myo::Quaternion<float>& reference) {
+  requested_[0].store(reference.x(), std::memory_order_relaxed);
+  requested_[1].store(reference.y(), std::memory_order_relaxed);
+  requested_[2].store(reference.z(), std::memory_order_relaxed);
+  requested_[3].store(reference.w(), std::memory_order_relaxed);
+  request_.store(SET, std::memory_order_release);
+}
+
+bool Calibration::isValidReference(const myo::Quaternion<float>& reference) {
+  float norm2 = reference.x() * reference.x() + reference.y() * reference.y() +
+    reference.z() * reference.z() + reference.w() * reference.w();
+  // a NaN or infinite component, or an overflow, makes the sum non-finite
+  return std::isfinite(norm2) && norm2 >= CALIBRATION_MIN_NORM * CALIBRATION_MIN_NORM;
+}
+
+void Calibration::setReference(const myo::Quaternion<float>& reference, bool yawOnly) {
+  // keeps the previous reference rather than turning every output into NaN
+  if (!isValidReference(reference))
+    return;
+  myo::Quaternion<float> ref = reference.normalized();
+  // just the heading: rotation about world z by the z-y-x yaw angle
+  float m[3][3];
+  toMatrix(ref, m);
+  float yaw = std::atan2(m[1][0], m[0][0]);
+  myo::Quaternion<float> heading(0, 0, std::sin(yaw / 2), std::cos(yaw / 2));
+  headingInverse_ = heading.conjugate();
+  inverse_ = yawOnly ? headingInverse_ : ref.conjugate();
+}
+
+myo::Quaternion<float> Calibration::apply(const myo::Quaternion<float>& quat, bool yawOnly) {
+  if (request_.load(std::memory_order_relaxed) != NONE) {
+    switch (request_.exchange(NONE, std::memory_order_acquire)) {
+      case CAPTURE:
+        setReference(quat, yawOnly);
+        break;
+      case RESET:
+        inverse_ = headingInverse_ = myo::Quaternion<float>();
+        break;
+      case SET:
+        setReference(myo::Quaternion<float>(requested_[0].load(std::memory_order_relaxed),
+                                            requested_[1].load(std::memory_order_relaxed),
+                                            requested_[2].load(std::memory_order_relaxed),
+                                            requested_[3].load(std::memory_order_relaxed)),
+                     yawOnly);
+        break;
+      default:
+        break;
+    }
+  }
+  return inverse_ * quat;
+}
+
+EulerConverter::EulerConverter() {
+  configure(EulerSettings(), OutputType());
+}
+
+bool EulerConverter::differs(const EulerSettings& euler, const OutputType& type) const {
+  for (int i = 0; i < 3; ++i) {
+    if (euler.axes[i] != euler_.axes[i])
+      return true;
+  }
+  return euler.unit != euler_.unit || type.scaling != scaling_ ||
+  type.inrange.min != inrange_.min || type.inrange.max != inrange_.max ||
+  type.outrange.min != outrange_.min || type.outrange.max != outrange_.max;
+}
+
+void EulerConverter::configure(const EulerSettings& euler, const OutputType& type) {
+  euler_ = euler;
+  scaling_ = type.scaling;
+  inrange_ = type.inrange;
+  outrange_ = type.outrange;
+  
+  // +1 for the cyclic orders (xyz, yzx, zxy), -1 for the others
+  int i = euler_.axes[0], j = euler_.axes[1];
+  parity_ = (j == (i + 1) % 3) ? 1.0f : -1.0f;
+  
+  switch (euler_.unit) {
+    case AngleUnit::DEGREES:
+      gain_ = static_cast<float>(180 / M_PI);
+      break;
+    case AngleUnit::NORMALIZED:
+      gain_ = static_cast<float>(1 / M_PI);
+      break;
+    case AngleUnit::RADIANS:
+    default:
+      gain_ = 1;
+      break;
+  }
+  offset_ = 0;
+  clamp_ = false;
+  if (scaling_ == Scaling::SCALE || scaling_ == Scaling::CLAMP) {
+    // (v - inmin) / (inmax - inmin) * (outmax - outmin) + outmin, as v * k + m
+    float k = (outrange_.max - outrange_.min) / (inrange_.max - inrange_.min);
+    offset_ = outrange_.min - inrange_.min * k;
+    gain_ *= k;
+    clamp_ = scaling_ == Scaling::CLAMP;
+    low_ = outrange_.min < outrange_.max ? outrange_.min : outrange_.max;
+    high_ = outrange_.min < outrange_.max ? outrange_.max : outrange_.min;
+  }
+}
+
+myo::Vector3<float> EulerConverter::convert(const myo::Quaternion<float>& quat, unsigned* clamps) const {
+  float m[3][3];
+  toMatrix(quat, m);
+  // R = R_i(a) R_j(b) R_k(c)
+  int i = euler_.axes[0], j = euler_.axes[1], k = euler_.axes[2];
+  float sinB = parity_ * m[i][k];
+  float angles[3] = {
+    std::atan2(-parity_ * m[j][k], m[k][k]),
+    std::asin(sinB > 1 ? 1 : sinB < -1 ? -1 : sinB),
+    std::atan2(-parity_ * m[i][j], m[i][i])
+  };
+  for (auto& angle : angles) {
+    angle = angle * gain_ + offset_;
+    if (clamp_) {
+      if (angle < low_) {
+        angle = low_;
+        ++*clamps;
+      } else if (angle > high_) {
+        angle = high_;
+        ++*clamps;
+      }
+    }
+  }
+  return myo::Vector3<float>(angles[0], angles[1], angles[2]);
+}
@@ -0,0 +1,136 @@
+// MyoOscOrientation.h
+//
+// Orientation processing between onOrientationData and the orientation
+// outputs: smoothing and short-horizon prediction. Everything here works on
+// a fixed amount of state, so it never allocates and costs the same for
+// every sample.
+
+#ifndef __MYO_OSC_ORIENTATION_H__
+#define __MYO_OSC_ORIENTATION_H__
+
+#include <atomic>
+#include <cstdint>
+
+#include <myo/myo.hpp>
+
+#include "MyoOscSettings.h"
+#include "MyoOscSimd.h"
+
+// The rotation of a unit quaternion as a matrix, built once per orientation
+// event and then applied to every vector that needs rotating (accel, gyro...).
+// Columns are padded to four floats so apply() is three SIMD multiply-adds.
+class Rotation {
+public:
+  Rotation();
+  explicit Rotation(const myo::Quaternion<float>& quat);
+
+  myo::Vector3<float> apply(const myo::Vector3<float>& vec) const;
+
+private:
+  float columns_[3][4];
+};
+
+// spherical interpolation along the shorter arc, t in [0, 1]
+myo::Quaternion<float> slerp(const myo::Quaternion<float>& from,
+                             const myo::Quaternion<float>& to, float t);
+
+// rotates quat further by the body-frame angular velocity gyro (deg/s, as
+// libmyo reports it) held for ms milliseconds
+myo::Quaternion<float> predictOrientation(const myo::Quaternion<float>& quat,
+                                          const myo::Vector3<float>& gyro, float ms);
+
+class OrientationFilter {
+public:
+  OrientationFilter();
+
+  // returns the smoothed orientation. timestamp is libmyo's, in
+  // microseconds. a change of settings restarts from the current sample.
+  myo::Quaternion<float> smooth(const OrientationFilterSettings& settings,
+                                const myo::Quaternion<float>& quat, uint64_t timestamp);
+
+private:
+  bool sameSettings(const OrientationFilterSettings& settings) const;
+
+  OrientationFilterSettings settings_;
+  bool primed_;
+  myo::Quaternion<float> filtered_;
+  uint64_t lastTimestamp_;
+  // low-passed angular speed in rad/s, for the one-euro cutoff
+  float speed_;
+};
+
+// smallest norm a requested reference may have, anything shorter can't be
+// normalized reliably
+#define CALIBRATION_MIN_NORM 1e-3f
+
+// The reference orientation. Other threads (the control channel) post
+// requests; the hub thread picks them up in apply(), so the callbacks never
+// wait on a lock. The reference is stored as its conjugate, making each
+// sample a single quaternion multiply with no re-normalization.
+class Calibration {
+public:
+  Calibration();
+
+  // take the next orientation sample as the reference
+  void requestCapture();
+  // go back to the device's own frame
+  void requestReset();
+  // use the given orientation as the reference
+  void requestReference(const myo::Quaternion<float>& reference);
+
+  // false for a reference with non-finite components or a norm below
+  // CALIBRATION_MIN_NORM, which setReference() would turn into NaNs
+  static bool isValidReference(const myo::Quaternion<float>& reference);
+
+  // hub thread only: handles any pending request, then returns quat
+  // relative to the reference
+  myo::Quaternion<float> apply(const myo::Quaternion<float>& quat, bool yawOnly);
+
+  // the inverse of just the reference's heading, whatever yawOnly is. the
+  // world-frame outputs use this so gravity stays on +z.
+  const myo::Quaternion<float>& headingInverse() const { return headingInverse_; }
+
+private:
+  enum Request {
+    NONE,
+    CAPTURE,
+    RESET,
+    SET
+  };
+
+  void setReference(const myo::Quaternion<float>& reference, bool yawOnly);
+
+  std::atomic<int> request_;
+  std::atomic<float> requested_[4];
+  myo::Quaternion<float> inverse_;
+  myo::Quaternion<float> headingInverse_;
+};
+
+// Quaternion to Euler angles in a configurable axis order, with the angle
+// unit and the output's linear in/out scaling folded into one gain and
+// offset, so each angle costs one atan2/asin, a multiply-add and an
+// optional clamp.
+class EulerConverter {
+public:
+  EulerConverter();
+
+  bool differs(const EulerSettings& euler, const OutputType& type) const;
+  void configure(const EulerSettings& euler, const OutputType& type);
+
+  myo::Vector3<float> convert(const myo::Quaternion<float>& quat, unsigned* clamps) const;
+
+private:
+  EulerSettings euler_;
+  Scaling scaling_;
+  Range inrange_;
+  Range outrange_;
+
+  float parity_;
+  float gain_;
+  float offset_;
+  bool clamp_;
+  float low_;
+  float high_;
+};
+
+#endif // __MYO_OSC_ORIENTATION_H__
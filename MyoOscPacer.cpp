@@ -0,0 +1,188 @@
+// MyoOscPacer.cpp
+
+#include "MyoOscPacer.h"
+
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+// same clock as ClockTranslator's host time
+static int64_t nowMicros() {
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+Pacer::Pacer(OscSender* sender, const PacingSettings& settings, std::size_t maxPacket)
+: sender_(sender)
+, settings_(settings)
+, maxPacket_(maxPacket)
+, storage_(settings.capacity * maxPacket)
+, entries_(settings.capacity)
+, free_(-1)
+, cursor_(0), held_(0), late_(0)
+, stopping_(false)
+{
+  for (int i = static_cast<int>(entries_.size()) - 1; i >= 0; --i) {
+    entries_[i].data = &storage_[i * maxPacket_];
+    entries_[i].next = free_;
+    free_ = i;
+  }
+  for (auto& slot : slots_)
+    slot = -1;
+}
+
+Pacer::~Pacer() {
+  stop();
+}
+
+void Pacer::start() {
+  stopping_ = false;
+  thread_ = std::thread(&Pacer::run, this);
+}
+
+void Pacer::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (thread_.joinable())
+    thread_.join();
+}
+
+void Pacer::prefault() {
+  std::memset(&storage_[0], 0, storage_.size());
+}
+
+void Pacer::schedule(int64_t due, const char* data, std::size_t size, OutputId id, Priority priority) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_ < 0 || size > maxPacket_) {
+    sender_->drop(id);
+    return;
+  }
+  int64_t ms = due / 1000;
+  if (held_ == 0) {
+    cursor_ = ms;
+  } else if (ms < cursor_) {
+    // already late, goes out with the next slot
+    ms = cursor_;
+  } else if (ms >= cursor_ + PACER_SLOTS) {
+    ms = cursor_ + PACER_SLOTS - 1;
+    due = ms * 1000;
+  }
+
+  int index = free_;
+  Entry& entry = entries_[index];
+  free_ = entry.next;
+  entry.due = due;
+  entry.size = size;
+  entry.id = id;
+  entry.priority = priority;
+  std::memcpy(entry.data, data, size);
+
+  // keep the slot sorted, later packets usually go at the end
+  int* link = &slots_[ms % PACER_SLOTS];
+  while (*link >= 0 && entries_[*link].due <= due)
+    link = &entries_[*link].next;
+  entry.next = *link;
+  *link = index;
+  if (++held_ == 1)
+    wake_.notify_one();
+}
+
+int64_t Pacer::nextDue() {
+  for (int i = 0; i < PACER_SLOTS; ++i) {
+    int head = slots_[(cursor_ + i) % PACER_SLOTS];
+    if (head >= 0) {
+      cursor_ += i;
+      return entries_[head].due;
+    }
+  }
+  return 0;
+}
+
+void Pacer::sleepUntil(int64_t due) const {
+  int64_t wake = due - settings_.spin;
+  if (wake > nowMicros()) {
+#if defined(__linux__)
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(wake / 1000000);
+    ts.tv_nsec = static_cast<long>(wake % 1000000) * 1000;
+    while (clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &ts, nullptr) == EINTR) { }
+#else
+    std::this_thread::sleep_until(std::chrono::system_clock::time_point(std::chrono::microseconds(wake)));
+#endif
+  }
+  // the sleep only gets within the scheduler's wake-up latency, spin the rest
+  while (nowMicros() < due) { }
+}
+
+void Pacer::run() {
+  if (init_)
+    init_();
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto ready = [this] { return stopping_ || held_ > 0; };
+  while (true) {
+    if (sender_->queued() == 0) {
+      wake_.wait(lock, ready);
+    } else if (!wake_.wait_for(lock, std::chrono::milliseconds(PACER_RETRY_INTERVAL), ready)) {
+      // packets the socket turned away would otherwise wait for the next send
+      lock.unlock();
+      sender_->flush();
+      lock.lock();
+      continue;
+    }
+    // held packets are still sent on stop, just without waiting for them
+    if (held_ == 0)
+      break;
+    int64_t due = nextDue();
+    if (!stopping_) {
+      lock.unlock();
+      sleepUntil(due);
+      lock.lock();
+    }
+
+    // take everything due from the slot, then send without the lock so
+    // schedule() isn't held up by the socket
+    int64_t now = nowMicros();
+    int* slot = &slots_[cursor_ % PACER_SLOTS];
+    int first = *slot;
+    int* link = slot;
+    while (*link >= 0 && (stopping_ || entries_[*link].due <= now)) {
+      link = &entries_[*link].next;
+      --held_;
+    }
+    if (link == slot) {
+      // woke early, nothing to send yet
+      continue;
+    }
+    *slot = *link;
+    *link = -1;
+    lock.unlock();
+
+    int last = -1;
+    for (int i = first; i >= 0; i = entries_[i].next) {
+      const Entry& entry = entries_[i];
+      if (now - entry.due > settings_.spin)
+        late_.fetch_add(1, std::memory_order_relaxed);
+      try {
+        sender_->send(entry.data, entry.size, entry.id, entry.priority);
+      } catch (const std::exception& e) {
+        std::cerr << "Error sending paced packet: " << e.what() << std::endl;
+      }
+      last = i;
+    }
+
+    lock.lock();
+    if (last >= 0) {
+      entries_[last].next = free_;
+      free_ = first;
+    }
+  }
+}
@@ -0,0 +1,97 @@
+// MyoOscPacer.h
+//
+// Evens out delivery. libmyo hands events over in clumps, so instead of
+// sending each packet as soon as it's built, the pacer holds it in a timing
+// wheel under the wall-clock time its event was sampled plus a fixed delay,
+// and a thread of its own sends it at that instant: a clock_nanosleep until
+// shortly before, then a busy-wait for the rest. The wheel has one slot per
+// millisecond and packet storage is allocated up front. The sender is only
+// used from the pacer thread, which also retries its queue.
+
+#ifndef __MYO_OSC_PACER_H__
+#define __MYO_OSC_PACER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MyoOscSender.h"
+#include "MyoOscSettings.h"
+
+// wheel slots, one per ms, so also the furthest ahead a packet can be held
+#define PACER_SLOTS 256
+
+// ms between retries of packets the sender had to queue, while nothing else
+// is due
+#define PACER_RETRY_INTERVAL 2
+
+class Pacer {
+public:
+  // packets can be up to maxPacket bytes
+  Pacer(OscSender* sender, const PacingSettings& settings,
+        std::size_t maxPacket = OUTPUT_BUFFER_SIZE);
+  ~Pacer();
+
+  // called on the pacer thread before anything is sent. must be set before
+  // start().
+  void setThreadInit(std::function<void()> init) { init_ = init; }
+
+  void start();
+
+  // sends whatever is still held, then waits for the thread to exit
+  void stop();
+
+  // copies a packet to be sent at due, in microseconds since the Unix epoch.
+  // a packet that's already due goes out as soon as possible.
+  void schedule(int64_t due, const char* data, std::size_t size, OutputId id, Priority priority);
+
+  // touches the packet storage ahead of the first event
+  void prefault();
+
+  // packets sent more than the spin time after they were due
+  uint64_t late() const { return late_.load(std::memory_order_relaxed); }
+
+private:
+  struct Entry {
+    int64_t due;
+    std::size_t size;
+    OutputId id;
+    Priority priority;
+    // next entry in the same slot or the free list, -1 at the end
+    int next;
+    // maxPacket_ bytes in storage_
+    char* data;
+  };
+
+  void run();
+  // due time of the earliest held packet, moving cursor_ up to its slot.
+  // only call with the lock held and something held.
+  int64_t nextDue();
+  void sleepUntil(int64_t due) const;
+
+  OscSender* sender_;
+  PacingSettings settings_;
+  std::size_t maxPacket_;
+  std::vector<char> storage_;
+  std::vector<Entry> entries_;
+  int free_;
+  // each slot is a list sorted by due time
+  int slots_[PACER_SLOTS];
+  // the ms that slot lookups start from; every held packet is due in
+  // [cursor_, cursor_ + PACER_SLOTS) ms
+  int64_t cursor_;
+  int held_;
+  std::atomic<uint64_t> late_;
+
+  std::function<void()> init_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_;
+};
+
+#endif // __MYO_OSC_PACER_H__
@@ -0,0 +1,87 @@
+// MyoOscRealtime.cpp
+
+#include "MyoOscRealtime.h"
+
+#include <cstring>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+#if defined(_WIN32)
+
+void applyThreadRealtime(const RealtimeSettings& realtime, int cpu, const char* name) {
+  HANDLE thread = GetCurrentThread();
+  // windows has no FIFO/RR distinction, both map to the highest priority
+  if (realtime.policy != SchedPolicy::DEFAULT &&
+      !SetThreadPriority(thread, THREAD_PRIORITY_TIME_CRITICAL)) {
+    std::cerr << "Unable to raise " << name << " thread priority" << std::endl;
+  }
+  if (cpu >= 0 &&
+      SetThreadAffinityMask(thread, static_cast<DWORD_PTR>(1) << cpu) == 0) {
+    std::cerr << "Unable to pin " << name << " thread to cpu " << cpu << std::endl;
+  }
+}
+
+bool lockProcessMemory() {
+  std::cerr << "Memory locking is not supported on this platform" << std::endl;
+  return false;
+}
+
+#else
+
+void applyThreadRealtime(const RealtimeSettings& realtime, int cpu, const char* name) {
+  if (realtime.policy != SchedPolicy::DEFAULT) {
+    int policy = realtime.policy == SchedPolicy::FIFO ? SCHED_FIFO : SCHED_RR;
+    int minPriority = sched_get_priority_min(policy);
+    int maxPriority = sched_get_priority_max(policy);
+    sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = realtime.priority < minPriority ? minPriority :
+    realtime.priority > maxPriority ? maxPriority : realtime.priority;
+    int err = pthread_setschedparam(pthread_self(), policy, &param);
+    if (err != 0) {
+      std::cerr << "Unable to set " << name << " thread scheduling: "
+      << std::strerror(err) << std::endl;
+    }
+  }
+  
+  if (cpu >= 0) {
+#if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (err != 0) {
+      std::cerr << "Unable to pin " << name << " thread to cpu " << cpu << ": "
+      << std::strerror(err) << std::endl;
+    }
+#else
+    // OS X only offers affinity tags as a hint, not pinning
+    std::cerr << "Unable to pin " << name << " thread: not supported on this platform" << std::endl;
+#endif
+  }
+}
+
+bool lockProcessMemory() {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    std::cerr << "Unable to lock memory: " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  return true;
+}
+
+#endif
+
+void prefaultStack() {
+  volatile char stack[PREFAULT_STACK_SIZE];
+  for (int i = 0; i < PREFAULT_STACK_SIZE; i += 4096)
+    stack[i] = 0;
+  (void)stack;
+}
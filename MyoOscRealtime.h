@@ -0,0 +1,25 @@
+// MyoOscRealtime.h
+//
+// Scheduling, CPU affinity and memory locking for the hub and timer threads.
+// Failures are reported on stderr and otherwise ignored: without the right
+// privileges myo-osc still runs, just with ordinary scheduling.
+
+#ifndef __MYO_OSC_REALTIME_H__
+#define __MYO_OSC_REALTIME_H__
+
+#include "MyoOscSettings.h"
+
+#define PREFAULT_STACK_SIZE (64 * 1024)
+
+// applies the scheduling policy and, if cpu >= 0, pins the calling thread
+// to that core. name is only used in warnings.
+void applyThreadRealtime(const RealtimeSettings& realtime, int cpu, const char* name);
+
+// locks current and future pages of the process into memory
+bool lockProcessMemory();
+
+// touches PREFAULT_STACK_SIZE bytes of the calling thread's stack, so the
+// pages are already mapped when a deep callback first needs them
+void prefaultStack();
+
+#endif // __MYO_OSC_REALTIME_H__
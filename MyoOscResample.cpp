@@ -0,0 +1,137 @@
+// MyoOscResample.cpp
+
+#include "MyoOscResample.h"
+#include "MyoOscOrientation.h"
+
+#include <algorithm>
+
+// a gap this long (e.g. a reconnect) restarts the clock rather than
+// producing a burst of held frames, in microseconds
+#define RESAMPLE_MAX_GAP 1000000
+
+static const int streamWidths[] = { 4, 3, 3, 8, 1 };
+
+Resampler::Resampler()
+: period_(0), delay_(0), newest_(0), nextTick_(0), started_(false) {
+  settings_.rate = 0;
+  configure(FrameSettings());
+}
+
+bool Resampler::differs(const FrameSettings& settings) const {
+  if (settings.rate != settings_.rate || settings.delay != settings_.delay)
+    return true;
+  for (int i = 0; i < static_cast<int>(FrameStream::COUNT); ++i) {
+    if (settings.streams[i] != settings_.streams[i])
+      return true;
+  }
+  return false;
+}
+
+void Resampler::configure(const FrameSettings& settings) {
+  settings_ = settings;
+  period_ = static_cast<uint64_t>(1000000 / settings_.rate);
+  delay_ = static_cast<uint64_t>(settings_.delay * 1000);
+  for (int i = 0; i < static_cast<int>(FrameStream::COUNT); ++i) {
+    streams_[i].width = streamWidths[i];
+    streams_[i].head = 0;
+    streams_[i].count = 0;
+    streams_[i].cursor = 0;
+  }
+  newest_ = 0;
+  nextTick_ = 0;
+  started_ = false;
+}
+
+void Resampler::add(FrameStream id, uint64_t timestamp, const float* values) {
+  Stream& stream = streams_[static_cast<int>(id)];
+  if (stream.count > 0) {
+    uint64_t last = stream.times[(stream.head + stream.count - 1) % RESAMPLE_RING];
+    if (timestamp < last)
+      timestamp = last;
+  }
+  int slot;
+  if (stream.count < RESAMPLE_RING) {
+    slot = (stream.head + stream.count) % RESAMPLE_RING;
+    ++stream.count;
+  } else {
+    slot = stream.head;
+    stream.head = (stream.head + 1) % RESAMPLE_RING;
+    if (stream.cursor > 0)
+      --stream.cursor;
+  }
+  stream.times[slot] = timestamp;
+  std::copy(values, values + stream.width, stream.values[slot]);
+
+  if (timestamp <= newest_)
+    return;
+  if (started_ && timestamp - newest_ > RESAMPLE_MAX_GAP)
+    started_ = false;
+  newest_ = timestamp;
+}
+
+int Resampler::next(uint64_t* timestamp, float* frame) {
+  if (!started_) {
+    // wait for a sample from every included stream, then start on a tick
+    // boundary
+    uint64_t oldest = 0;
+    for (int i = 0; i < static_cast<int>(FrameStream::COUNT); ++i) {
+      if (!settings_.streams[i])
+        continue;
+      const Stream& stream = streams_[i];
+      if (stream.count == 0)
+        return 0;
+      oldest = std::max(oldest, stream.times[stream.head]);
+    }
+    if (newest_ < delay_)
+      return 0;
+    nextTick_ = std::max(oldest, newest_ - delay_);
+    if (nextTick_ % period_)
+      nextTick_ += period_ - nextTick_ % period_;
+    for (auto& stream : streams_)
+      stream.cursor = 0;
+    started_ = true;
+  }
+  if (nextTick_ + delay_ > newest_)
+    return 0;
+
+  int size = 0;
+  for (int i = 0; i < static_cast<int>(FrameStream::COUNT); ++i) {
+    if (!settings_.streams[i])
+      continue;
+    sample(streams_[i], static_cast<FrameStream>(i), nextTick_, frame + size);
+    size += streams_[i].width;
+  }
+  *timestamp = nextTick_;
+  nextTick_ += period_;
+  return size;
+}
+
+void Resampler::sample(Stream& stream, FrameStream id, uint64_t time, float* out) {
+  // ticks only move forward, so skip past samples no later than time
+  while (stream.cursor + 1 < stream.count &&
+         stream.times[(stream.head + stream.cursor + 1) % RESAMPLE_RING] <= time)
+    ++stream.cursor;
+  int a = (stream.head + stream.cursor) % RESAMPLE_RING;
+  if (stream.cursor + 1 >= stream.count || stream.times[a] >= time ||
+      id == FrameStream::RSSI) {
+    // before the first sample, past the last or stepped: hold the nearest
+    std::copy(stream.values[a], stream.values[a] + stream.width, out);
+    return;
+  }
+  int b = (a + 1) % RESAMPLE_RING;
+  float t = static_cast<float>(time - stream.times[a]) /
+  static_cast<float>(stream.times[b] - stream.times[a]);
+  const float* va = stream.values[a];
+  const float* vb = stream.values[b];
+  if (id == FrameStream::ORIENTATION) {
+    myo::Quaternion<float> q = slerp(myo::Quaternion<float>(va[0], va[1], va[2], va[3]),
+                                     myo::Quaternion<float>(vb[0], vb[1], vb[2], vb[3]), t);
+    out[0] = q.x();
+    out[1] = q.y();
+    out[2] = q.z();
+    out[3] = q.w();
+    return;
+  }
+  for (int i = 0; i < stream.width; ++i)
+    out[i] = va[i] + (vb[i] - va[i]) * t;
+}
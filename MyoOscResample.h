@@ -0,0 +1,65 @@
+// MyoOscResample.h
+//
+// Puts the independently clocked sensor streams onto one output clock.
+// Each stream keeps its recent samples, keyed on the libmyo timestamps, in a
+// small fixed ring; a frame for tick time T is produced once some stream has
+// reached T + delay, by interpolating every included stream at T (slerp for
+// the orientation, linear for the rest, sample-and-hold for RSSI). Nothing
+// allocates after construction.
+
+#ifndef __MYO_OSC_RESAMPLE_H__
+#define __MYO_OSC_RESAMPLE_H__
+
+#include <cstdint>
+
+#include "MyoOscSettings.h"
+
+// samples kept per stream, enough for 250ms of delay at EMG's 200Hz
+#define RESAMPLE_RING 64
+// values in the widest stream (EMG)
+#define RESAMPLE_MAX_WIDTH 8
+// floats in a frame with every stream included
+#define RESAMPLE_MAX_FRAME (4 + 3 + 3 + 8 + 1)
+
+class Resampler {
+public:
+  Resampler();
+
+  bool differs(const FrameSettings& settings) const;
+
+  // drops all samples and restarts the clock
+  void configure(const FrameSettings& settings);
+
+  // timestamps are libmyo's, in microseconds. a sample older than the
+  // stream's newest is taken as arriving at the newest time.
+  void add(FrameStream stream, uint64_t timestamp, const float* values);
+
+  // fills frame with the next due frame and returns its size, or returns 0
+  // if none is due. call until it returns 0 after each add().
+  int next(uint64_t* timestamp, float* frame);
+
+private:
+  struct Stream {
+    int width;
+    uint64_t times[RESAMPLE_RING];
+    float values[RESAMPLE_RING][RESAMPLE_MAX_WIDTH];
+    // ring position of the oldest sample, and how many there are
+    int head;
+    int count;
+    // samples before this (relative to head) are older than the next tick,
+    // so the search for the next one starts here
+    int cursor;
+  };
+
+  void sample(Stream& stream, FrameStream id, uint64_t time, float* out);
+
+  FrameSettings settings_;
+  Stream streams_[static_cast<int>(FrameStream::COUNT)];
+  uint64_t period_;
+  uint64_t delay_;
+  uint64_t newest_;
+  uint64_t nextTick_;
+  bool started_;
+};
+
+#endif // __MYO_OSC_RESAMPLE_H__
@@ -0,0 +1,155 @@
+// MyoOscSender.cpp
+
+#include "MyoOscSender.h"
+#include "MyoOscStats.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+OscSender::OscSender(const std::string& hostname, int port, const SendSettings& settings,
+                     Stats* stats, std::size_t maxPacket)
+: socket_(nullptr)
+, settings_(settings)
+, stats_(stats)
+, maxPacket_(maxPacket)
+, storage_(settings.queueLength * maxPacket)
+, slots_(settings.queueLength)
+, order_(settings.queueLength)
+, queuedHead_(0), queuedCount_(0)
+{
+  for (std::size_t i = 0; i < slots_.size(); ++i)
+    slots_[i].data = &storage_[i * maxPacket_];
+  socket_ = new UdpTransmitSocket(IpEndpointName(hostname.c_str(), port));
+  if (settings_.bufferSize > 0 &&
+      !socket_->SetSendBufferSize(settings_.bufferSize)) {
+    std::cerr << "Unable to set send buffer size to " << settings_.bufferSize << std::endl;
+  }
+  if (settings_.nonBlocking)
+    socket_->SetNonBlocking(true);
+  freeSlots_.reserve(slots_.size());
+  for (std::size_t i = slots_.size(); i > 0; --i)
+    freeSlots_.push_back(i - 1);
+}
+
+OscSender::~OscSender() {
+  if (socket_ != nullptr) {
+    delete socket_;
+  }
+}
+
+bool OscSender::transmit(const char* data, std::size_t size) {
+  switch (socket_->TrySend(data, size)) {
+    case UdpSocket::SEND_OK:
+      counters_.sent.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    case UdpSocket::SEND_WOULD_BLOCK:
+      return false;
+    case UdpSocket::SEND_ERROR:
+    default:
+      // nothing listening on loopback (ECONNREFUSED) and the like. the
+      // packet is gone either way, so don't hold up the queue for it.
+      counters_.errored.fetch_add(1, std::memory_order_relaxed);
+      return true;
+  }
+}
+
+void OscSender::send(const char* data, std::size_t size, OutputId id, Priority priority) {
+  if (flush() && transmit(data, size))
+    return;
+  enqueue(data, size, id, priority);
+}
+
+bool OscSender::flush() {
+  while (queuedCount_ > 0) {
+    std::size_t slot = order_[queuedHead_];
+    if (!transmit(slots_[slot].data, slots_[slot].size))
+      return false;
+    freeSlots_.push_back(slot);
+    queuedHead_ = (queuedHead_ + 1) % order_.size();
+    --queuedCount_;
+  }
+  return true;
+}
+
+bool OscSender::drain(int timeoutMs) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+  while (!flush()) {
+    if (std::chrono::steady_clock::now() >= deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+void OscSender::drop(OutputId id) {
+  counters_.dropped.fetch_add(1, std::memory_order_relaxed);
+  if (stats_)
+    stats_->countDrop(id);
+}
+
+void OscSender::prefault() {
+  if (!storage_.empty())
+    std::memset(&storage_[0], 0, storage_.size());
+}
+
+void OscSender::evict(std::size_t orderIndex) {
+  std::size_t slot = queuedAt(orderIndex);
+  freeSlots_.push_back(slot);
+  // close the gap from the front, the victim is usually near it
+  for (std::size_t i = orderIndex; i > 0; --i)
+    queuedAt(i) = queuedAt(i - 1);
+  queuedHead_ = (queuedHead_ + 1) % order_.size();
+  --queuedCount_;
+  counters_.dropped.fetch_add(1, std::memory_order_relaxed);
+  if (stats_)
+    stats_->countDrop(slots_[slot].id);
+}
+
+void OscSender::enqueue(const char* data, std::size_t size, OutputId id, Priority priority) {
+  if (size > maxPacket_ || slots_.empty()) {
+    drop(id);
+    return;
+  }
+  if (freeSlots_.empty()) {
+    // prefer giving up the oldest continuous packet, a newer one will
+    // replace it soon enough
+    std::size_t victim = queuedCount_;
+    for (std::size_t i = 0; i < queuedCount_; ++i) {
+      if (slots_[queuedAt(i)].priority == Priority::STREAM) {
+        victim = i;
+        break;
+      }
+    }
+    bool dropIncoming;
+    if (victim == queuedCount_) {
+      // queue is all events: a stream packet never displaces one
+      dropIncoming = priority == Priority::STREAM ||
+      settings_.dropPolicy == DropPolicy::DROP_NEWEST;
+      victim = 0;
+    } else {
+      dropIncoming = priority == Priority::STREAM &&
+      settings_.dropPolicy == DropPolicy::DROP_NEWEST;
+    }
+    if (dropIncoming) {
+      drop(id);
+      return;
+    }
+    evict(victim);
+  }
+  std::size_t slot = freeSlots_.back();
+  freeSlots_.pop_back();
+  QueuedPacket& packet = slots_[slot];
+  std::memcpy(packet.data, data, size);
+  packet.size = size;
+  packet.id = id;
+  packet.priority = priority;
+  queuedAt(queuedCount_++) = slot;
+}
+
+std::ostream& operator<<(std::ostream& os, const SendCounters& counters) {
+  return os << "sent: " << counters.sent.load()
+  << ", dropped: " << counters.dropped.load()
+  << ", errored: " << counters.errored.load();
+}
@@ -0,0 +1,104 @@
+// MyoOscSender.h
+//
+// Sends finished OSC packets to a single destination, holding packets back in a
+// small queue while the socket is full instead of stalling the libmyo callback
+// thread. Overflow is resolved by the configured DropPolicy, with discrete
+// events taking precedence over continuous streams.
+
+#ifndef __MYO_OSC_SENDER_H__
+#define __MYO_OSC_SENDER_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ip/UdpSocket.h"
+
+#include "MyoOscSettings.h"
+
+#define OUTPUT_BUFFER_SIZE 1024
+
+class Stats;
+
+// updated only by the sending thread, but may be read from any thread
+struct SendCounters {
+  std::atomic<uint64_t> sent;
+  std::atomic<uint64_t> dropped;
+  std::atomic<uint64_t> errored;
+
+  SendCounters() : sent(0), dropped(0), errored(0) { }
+};
+
+class OscSender {
+public:
+  // queued packets can be up to maxPacket bytes, larger ones are dropped
+  // if they can't be sent straight away
+  OscSender(const std::string& hostname, int port, const SendSettings& settings,
+            Stats* stats = nullptr, std::size_t maxPacket = OUTPUT_BUFFER_SIZE);
+  ~OscSender();
+
+  // sends (or queues) a packet. never throws on socket errors, those are
+  // counted instead.
+  void send(const char* data, std::size_t size, const OutputType& type) {
+    send(data, size, type.id, type.priority);
+  }
+  void send(const char* data, std::size_t size, OutputId id, Priority priority);
+
+  // counts a packet that was given up before it reached send()
+  void drop(OutputId id);
+
+  // retries any queued packets, returns true if the queue is now empty.
+  // only call from the thread that sends.
+  bool flush();
+
+  // keeps retrying until the queue is empty or timeoutMs has passed, for
+  // shutdown. returns false if packets were left behind.
+  bool drain(int timeoutMs);
+
+  std::size_t queued() const { return queuedCount_; }
+
+  // writes to every queue slot so its pages are resident before the first
+  // overflow rather than during it
+  void prefault();
+
+  const SendCounters& counters() const { return counters_; }
+
+private:
+  struct QueuedPacket {
+    std::size_t size;
+    OutputId id;
+    Priority priority;
+    // maxPacket_ bytes in storage_
+    char* data;
+  };
+
+  // attempts to transmit, returns false only if the socket would block
+  bool transmit(const char* data, std::size_t size);
+  void enqueue(const char* data, std::size_t size, OutputId id, Priority priority);
+  void evict(std::size_t orderIndex);
+  // slot index of the orderIndex'th oldest queued packet
+  std::size_t& queuedAt(std::size_t orderIndex) {
+    return order_[(queuedHead_ + orderIndex) % order_.size()];
+  }
+
+  UdpTransmitSocket* socket_;
+  SendSettings settings_;
+  SendCounters counters_;
+  Stats* stats_;
+
+  // packet storage is allocated up front. order_ is a ring of slot indices,
+  // oldest first from queuedHead_.
+  std::size_t maxPacket_;
+  std::vector<char> storage_;
+  std::vector<QueuedPacket> slots_;
+  std::vector<std::size_t> freeSlots_;
+  std::vector<std::size_t> order_;
+  std::size_t queuedHead_;
+  std::size_t queuedCount_;
+};
+
+std::ostream& operator<<(std::ostream& os, const SendCounters& counters);
+
+#endif // __MYO_OSC_SENDER_H__
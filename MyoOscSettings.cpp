@@ -93,6 +93,455 @@ namespace reader {
     throw std::invalid_argument("Invalid scaling value: " + val.serialize());
   }
   
+  static void readPriority(const value& val, Priority* out) {
+    if (isnull(val))
+      return;
+    if (val.is<std::string>()) {
+      const auto& str = val.get<std::string>();
+      if (str == "stream")
+        *out = Priority::STREAM;
+      else if (str == "event")
+        *out = Priority::EVENT;
+      else
+        throw std::invalid_argument("Invalid priority value: " + val.serialize());
+      return;
+    }
+    throw std::invalid_argument("Invalid priority value: " + val.serialize());
+  }
+  
+  static void readEncoding(const value& val, Encoding* out) {
+    if (isnull(val))
+      return;
+    if (val.is<std::string>()) {
+      const auto& str = val.get<std::string>();
+      if (str == "float")
+        *out = Encoding::FLOAT;
+      else if (str == "half")
+        *out = Encoding::HALF;
+      else if (str == "int16")
+        *out = Encoding::INT16;
+      else
+        throw std::invalid_argument("Invalid encoding value: " + val.serialize());
+      return;
+    }
+    throw std::invalid_argument("Invalid encoding value: " + val.serialize());
+  }
+  
+  static void readDropPolicy(const value& val, DropPolicy* out) {
+    if (isnull(val))
+      return;
+    if (val.is<std::string>()) {
+      const auto& str = val.get<std::string>();
+      if (str == "oldest")
+        *out = DropPolicy::DROP_OLDEST;
+      else if (str == "newest")
+        *out = DropPolicy::DROP_NEWEST;
+      else
+        throw std::invalid_argument("Invalid drop policy value: " + val.serialize());
+      return;
+    }
+    throw std::invalid_argument("Invalid drop policy value: " + val.serialize());
+  }
+  
+  static void readSendSettings(const value& val, SendSettings* out) {
+    if (isnull(val))
+      return;
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid send settings value: " + val.serialize());
+    readBool(val.get("nonBlocking"), &out->nonBlocking);
+    readNumber(val.get("bufferSize"), &out->bufferSize);
+    readNumber(val.get("queue"), &out->queueLength);
+    readDropPolicy(val.get("dropPolicy"), &out->dropPolicy);
+    if (out->bufferSize < 0)
+      throw std::invalid_argument("Invalid send buffer size: " + val.serialize());
+    if (out->queueLength < 0)
+      throw std::invalid_argument("Invalid send queue length: " + val.serialize());
+  }
+  
+  static void readPacingSettings(const value& val, PacingSettings* out) {
+    if (isnull(val))
+      return;
+    if (val.is<bool>()) {
+      out->enabled = val.get<bool>();
+      return;
+    }
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid pacing settings value: " + val.serialize());
+    out->enabled = true;
+    readBool(val.get("enabled"), &out->enabled);
+    readNumber(val.get("delay"), &out->delay);
+    readNumber(val.get("spin"), &out->spin);
+    readNumber(val.get("capacity"), &out->capacity);
+    // the timing wheel holds packets up to PACER_SLOTS ms ahead
+    if (!(out->delay >= 0 && out->delay <= 200))
+      throw std::invalid_argument("Invalid pacing delay, must be 0 to 200ms: " + val.serialize());
+    if (out->spin < 0 || out->spin > 10000)
+      throw std::invalid_argument("Invalid pacing spin, must be 0 to 10000us: " + val.serialize());
+    if (out->capacity <= 0)
+      throw std::invalid_argument("Invalid pacing capacity: " + val.serialize());
+  }
+  
+  static void readBundleSettings(const value& val, BundleSettings* out) {
+    if (isnull(val))
+      return;
+    if (val.is<bool>()) {
+      out->enabled = val.get<bool>();
+      return;
+    }
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid bundle settings value: " + val.serialize());
+    out->enabled = true;
+    readBool(val.get("enabled"), &out->enabled);
+    readNumber(val.get("mtu"), &out->mtu);
+    // 576 is the least every IPv4 host must accept, 65535 the most an IPv4
+    // datagram can be
+    if (out->mtu < 576 || out->mtu > 65535)
+      throw std::invalid_argument("Invalid bundle mtu, must be 576 to 65535: " + val.serialize());
+  }
+  
+  static void readStatsSettings(const value& val, StatsSettings* out) {
+    if (isnull(val))
+      return;
+    if (val.is<bool>()) {
+      out->enabled = val.get<bool>();
+      return;
+    }
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid stats settings value: " + val.serialize());
+    out->enabled = true;
+    readBool(val.get("enabled"), &out->enabled);
+    readString(val.get("host"), &out->hostname);
+    readNumber(val.get("port"), &out->port);
+    readNumber(val.get("interval"), &out->interval);
+    readString(val.get("file"), &out->file);
+    if (out->interval <= 0)
+      throw std::invalid_argument("Invalid stats interval: " + val.serialize());
+  }
+  
+  static void readHubSettings(const value& val, HubSettings* out) {
+    if (isnull(val))
+      return;
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid hub settings value: " + val.serialize());
+    readNumber(val.get("slice"), &out->slice);
+    readBool(val.get("runOnce"), &out->runOnce);
+    readNumber(val.get("rssiInterval"), &out->rssiInterval);
+    readNumber(val.get("keepAlive"), &out->keepAlive);
+    if (out->slice <= 0)
+      throw std::invalid_argument("Invalid hub slice: " + val.serialize());
+  }
+  
+  static void readSchedPolicy(const value& val, SchedPolicy* out) {
+    if (isnull(val))
+      return;
+    if (val.is<std::string>()) {
+      const auto& str = val.get<std::string>();
+      if (str == "default" || str == "other")
+        *out = SchedPolicy::DEFAULT;
+      else if (str == "fifo")
+        *out = SchedPolicy::FIFO;
+      else if (str == "rr")
+        *out = SchedPolicy::RR;
+      else
+        throw std::invalid_argument("Invalid scheduling policy value: " + val.serialize());
+      return;
+    }
+    throw std::invalid_argument("Invalid scheduling policy value: " + val.serialize());
+  }
+  
+  static void readRealtimeSettings(const value& val, RealtimeSettings* out) {
+    if (isnull(val))
+      return;
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid realtime settings value: " + val.serialize());
+    readSchedPolicy(val.get("policy"), &out->policy);
+    readNumber(val.get("priority"), &out->priority);
+    readNumber(val.get("hubCpu"), &out->hubCpu);
+    readNumber(val.get("timerCpu"), &out->timerCpu);
+    readNumber(val.get("pacerCpu"), &out->pacerCpu);
+    readBool(val.get("lockMemory"), &out->lockMemory);
+    readBool(val.get("prefault"), &out->prefault);
+  }
+  
+  static void readEnvelopeSettings(const value& val, EnvelopeSettings* out) {
+    if (!val.is<object>())
+      return;
+    readNumber(val.get("window"), &out->window);
+    readNumber(val.get("cutoff"), &out->cutoff);
+    if (out->window <= 0)
+      throw std::invalid_argument("Invalid envelope window: " + val.serialize());
+    if (out->cutoff <= 0)
+      throw std::invalid_argument("Invalid envelope cutoff: " + val.serialize());
+  }
+  
+  static void readBandSettings(const value& val, BandSettings* out) {
+    if (!val.is<object>())
+      return;
+    readNumber(val.get("window"), &out->window);
+    readNumber(val.get("hop"), &out->hop);
+    if (out->window < 8 || out->window > 1024)
+      throw std::invalid_argument("Invalid band window, must be 8 to 1024 samples: " + val.serialize());
+    if (out->hop <= 0 || out->hop > out->window)
+      throw std::invalid_argument("Invalid band hop, must be 1 to window samples: " + val.serialize());
+    const value& bandsval = val.get("bands");
+    if (isnull(bandsval))
+      return;
+    if (!bandsval.is<array>() || bandsval.get<array>().empty() ||
+        bandsval.get<array>().size() > EMG_MAX_BANDS)
+      throw std::invalid_argument("Invalid bands value: " + bandsval.serialize());
+    out->bands.clear();
+    for (const auto& bandval : bandsval.get<array>()) {
+      Range range;
+      readRange(bandval, &range);
+      if (range.min < 0 || range.max > outputSampleRate(OutputId::EMG) / 2 || range.min >= range.max)
+        throw std::invalid_argument("Invalid band: " + bandval.serialize());
+      FrequencyBand band = { range.min, range.max };
+      out->bands.push_back(band);
+    }
+  }
+  
+  static void readGestureSettings(const value& val, GestureSettings* out) {
+    if (!val.is<object>())
+      return;
+    readNumber(val.get("window"), &out->window);
+    readNumber(val.get("hop"), &out->hop);
+    readNumber(val.get("hold"), &out->hold);
+    readBool(val.get("vibrate"), &out->vibrate);
+    // at least two IMU samples, and one EMG sample per hop
+    if (out->window < 40 || out->window > 5000)
+      throw std::invalid_argument("Invalid gesture window, must be 40 to 5000ms: " + val.serialize());
+    if (out->hop < 5 || out->hop > out->window)
+      throw std::invalid_argument("Invalid gesture hop, must be 5ms to window: " + val.serialize());
+    if (out->hold < 1)
+      throw std::invalid_argument("Invalid gesture hold: " + val.serialize());
+    // reloaded every time the config is, so an edited model is picked up too
+    const value& modelval = val.get("model");
+    if (!isnull(modelval)) {
+      readString(modelval, &out->modelFile);
+      loadGestureModel(out->modelFile, &out->model);
+    }
+  }
+  
+  static void readFrameStream(const value& val, FrameStream* out) {
+    if (val.is<std::string>()) {
+      const auto& str = val.get<std::string>();
+      if (str == "orientation")
+        *out = FrameStream::ORIENTATION;
+      else if (str == "accel")
+        *out = FrameStream::ACCEL;
+      else if (str == "gyro")
+        *out = FrameStream::GYRO;
+      else if (str == "emg")
+        *out = FrameStream::EMG;
+      else if (str == "rssi")
+        *out = FrameStream::RSSI;
+      else
+        throw std::invalid_argument("Invalid frame stream value: " + val.serialize());
+      return;
+    }
+    throw std::invalid_argument("Invalid frame stream value: " + val.serialize());
+  }
+  
+  static void readFrameFormat(const value& val, FrameFormat* out) {
+    if (isnull(val))
+      return;
+    if (val.is<std::string>()) {
+      const auto& str = val.get<std::string>();
+      if (str == "flat")
+        *out = FrameFormat::FLAT;
+      else if (str == "arrays")
+        *out = FrameFormat::ARRAYS;
+      else
+        throw std::invalid_argument("Invalid frame format value: " + val.serialize());
+      return;
+    }
+    throw std::invalid_argument("Invalid frame format value: " + val.serialize());
+  }
+  
+  static void readFrameSettings(const value& val, FrameSettings* out) {
+    if (!val.is<object>())
+      return;
+    readNumber(val.get("rate"), &out->rate);
+    readNumber(val.get("delay"), &out->delay);
+    readFrameFormat(val.get("format"), &out->format);
+    readNumber(val.get("batch"), &out->batch);
+    if (out->batch < 1 || out->batch > FRAME_MAX_BATCH)
+      throw std::invalid_argument("Invalid frame batch, must be 1 to 64: " + val.serialize());
+    if (out->batch > 1 && out->format != FrameFormat::ARRAYS)
+      throw std::invalid_argument("Frame batches need the \"arrays\" format: " + val.serialize());
+    if (!(out->rate >= 1 && out->rate <= 1000))
+      throw std::invalid_argument("Invalid frame rate, must be 1 to 1000Hz: " + val.serialize());
+    // the stream rings hold a little over 250ms of EMG
+    if (!(out->delay >= 0 && out->delay <= 250))
+      throw std::invalid_argument("Invalid frame delay, must be 0 to 250ms: " + val.serialize());
+    const value& streamsval = val.get("streams");
+    if (isnull(streamsval))
+      return;
+    if (!streamsval.is<array>() || streamsval.get<array>().empty())
+      throw std::invalid_argument("Invalid frame streams value: " + streamsval.serialize());
+    for (auto& stream : out->streams)
+      stream = false;
+    for (const auto& streamval : streamsval.get<array>()) {
+      FrameStream stream;
+      readFrameStream(streamval, &stream);
+      out->streams[static_cast<int>(stream)] = true;
+    }
+  }
+  
+  static void readSmoothing(const value& val, Smoothing* out) {
+    if (isnull(val))
+      return;
+    if (val.is<std::string>()) {
+      const auto& str = val.get<std::string>();
+      if (str == "none")
+        *out = Smoothing::NONE;
+      else if (str == "exponential")
+        *out = Smoothing::EXPONENTIAL;
+      else if (str == "oneEuro")
+        *out = Smoothing::ONE_EURO;
+      else
+        throw std::invalid_argument("Invalid smoothing value: " + val.serialize());
+      return;
+    }
+    throw std::invalid_argument("Invalid smoothing value: " + val.serialize());
+  }
+  
+  static void readOrientationFilterSettings(const value& val, OrientationFilterSettings* out) {
+    if (isnull(val))
+      return;
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid orientation filter value: " + val.serialize());
+    readSmoothing(val.get("smoothing"), &out->smoothing);
+    readNumber(val.get("alpha"), &out->alpha);
+    readNumber(val.get("minCutoff"), &out->minCutoff);
+    readNumber(val.get("beta"), &out->beta);
+    readNumber(val.get("dCutoff"), &out->derivativeCutoff);
+    readNumber(val.get("predict"), &out->predict);
+    if (!(out->alpha > 0 && out->alpha <= 1))
+      throw std::invalid_argument("Invalid orientation filter alpha: " + val.serialize());
+    if (!(out->minCutoff > 0) || !(out->derivativeCutoff > 0) || out->beta < 0)
+      throw std::invalid_argument("Invalid orientation filter cutoff: " + val.serialize());
+    if (out->predict < 0)
+      throw std::invalid_argument("Invalid orientation prediction: " + val.serialize());
+  }
+  
+  static void readEulerSettings(const value& val, EulerSettings* out) {
+    if (isnull(val))
+      return;
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid euler settings value: " + val.serialize());
+    const value& orderval = val.get("order");
+    if (!isnull(orderval)) {
+      std::string order;
+      readString(orderval, &order);
+      if (order.size() != 3)
+        throw std::invalid_argument("Invalid euler order: " + orderval.serialize());
+      for (int i = 0; i < 3; ++i) {
+        if (order[i] < 'x' || order[i] > 'z')
+          throw std::invalid_argument("Invalid euler order: " + orderval.serialize());
+        out->axes[i] = order[i] - 'x';
+      }
+      // only Tait-Bryan orders, each axis once
+      if (out->axes[0] == out->axes[1] || out->axes[1] == out->axes[2] || out->axes[0] == out->axes[2])
+        throw std::invalid_argument("Invalid euler order: " + orderval.serialize());
+    }
+    const value& unitval = val.get("units");
+    if (!isnull(unitval)) {
+      std::string unit;
+      readString(unitval, &unit);
+      if (unit == "rad")
+        out->unit = AngleUnit::RADIANS;
+      else if (unit == "deg")
+        out->unit = AngleUnit::DEGREES;
+      else if (unit == "normalized")
+        out->unit = AngleUnit::NORMALIZED;
+      else
+        throw std::invalid_argument("Invalid euler units: " + unitval.serialize());
+    }
+  }
+  
+  static void readCalibrationSettings(const value& val, CalibrationSettings* out) {
+    if (isnull(val))
+      return;
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid calibration settings value: " + val.serialize());
+    readBool(val.get("onSync"), &out->onSync);
+    readBool(val.get("yawOnly"), &out->yawOnly);
+  }
+  
+  static void readControlSettings(const value& val, ControlSettings* out) {
+    if (isnull(val))
+      return;
+    if (val.is<bool>()) {
+      out->enabled = val.get<bool>();
+      return;
+    }
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid control settings value: " + val.serialize());
+    out->enabled = true;
+    readBool(val.get("enabled"), &out->enabled);
+    readNumber(val.get("port"), &out->port);
+  }
+  
+  static void readTimeTagSettings(const value& val, TimeTagSettings* out) {
+    if (isnull(val))
+      return;
+    if (val.is<bool>()) {
+      out->enabled = val.get<bool>();
+      return;
+    }
+    if (!val.is<object>())
+      throw std::invalid_argument("Invalid time tag settings value: " + val.serialize());
+    out->enabled = true;
+    readBool(val.get("enabled"), &out->enabled);
+    readNumber(val.get("block"), &out->block);
+    readNumber(val.get("window"), &out->window);
+    if (out->block <= 0)
+      throw std::invalid_argument("Invalid time tag block: " + val.serialize());
+    if (!(out->window > 0))
+      throw std::invalid_argument("Invalid time tag window: " + val.serialize());
+  }
+  
+  static void readFilterKind(const value& val, FilterKind* out) {
+    if (val.is<std::string>()) {
+      const auto& str = val.get<std::string>();
+      if (str == "lowpass")
+        *out = FilterKind::LOWPASS;
+      else if (str == "highpass")
+        *out = FilterKind::HIGHPASS;
+      else if (str == "bandpass")
+        *out = FilterKind::BANDPASS;
+      else if (str == "notch")
+        *out = FilterKind::NOTCH;
+      else
+        throw std::invalid_argument("Invalid filter type value: " + val.serialize());
+      return;
+    }
+    throw std::invalid_argument("Invalid filter type value: " + val.serialize());
+  }
+  
+  static void readFilters(const value& val, OutputType* out) {
+    if (isnull(val))
+      return;
+    if (!val.is<array>())
+      throw std::invalid_argument("Invalid filters value: " + val.serialize());
+    float sampleRate = outputSampleRate(out->id);
+    if (out->id != OutputId::ACCEL && out->id != OutputId::GYRO && out->id != OutputId::EMG)
+      throw std::invalid_argument(std::string("Filters are not supported for ") + outputIdName(out->id));
+    out->filters.clear();
+    out->biquads.clear();
+    for (const auto& fval : val.get<array>()) {
+      if (!fval.is<object>())
+        throw std::invalid_argument("Invalid filter value: " + fval.serialize());
+      FilterSpec spec;
+      readFilterKind(fval.get("type"), &spec.kind);
+      readNumber(fval.get("freq"), &spec.freq);
+      readNumber(fval.get("q"), &spec.q);
+      out->filters.push_back(spec);
+      out->biquads.push_back(designBiquad(spec, sampleRate));
+    }
+  }
+  
   static void readOutputType(const value& val, OutputType* out) {
     if (isnull(val)) {
       out->enabled = false;
@@ -123,6 +572,8 @@ namespace reader {
           else
             throw std::invalid_argument("Invalid OutputType path value: " + pathval.serialize());
         }
+        readPriority(val.get("priority"), &out->priority);
+        readFilters(val.get("filters"), out);
         auto inval = val.get("in");
         auto outval = val.get("out");
         if (!isnull(inval) ||
@@ -132,6 +583,11 @@ namespace reader {
           readRange(inval, &out->inrange);
           readRange(outval, &out->outrange);
         }
+        readEncoding(val.get("encoding"), &out->encoding);
+        // int16 spans the out range, so it needs one
+        if (out->encoding == Encoding::INT16 &&
+            (out->scaling == Scaling::NONE || out->outrange.min == out->outrange.max))
+          throw std::invalid_argument("Invalid OutputType encoding, int16 needs an \"in\" and a non-empty \"out\" range: " + val.serialize());
       }
       return;
     }
@@ -153,6 +609,13 @@ namespace reader {
       out->emg.enabled = true;
       out->sync.enabled = true;
       out->rssi.enabled = true;
+      out->emgEnvelope.enabled = true;
+      out->emgBands.enabled = true;
+      out->worldAccel.enabled = true;
+      out->linearAccel.enabled = true;
+      out->worldGyro.enabled = true;
+      out->gesture.enabled = true;
+      out->frame.enabled = true;
     }
 #define READ_TYPE(type) do {\
   std::cout << "reading " << #type << "..." << std::endl;\
@@ -167,12 +630,34 @@ namespace reader {
     READ_TYPE(emg);
     READ_TYPE(sync);
     READ_TYPE(rssi);
+    READ_TYPE(emgEnvelope);
+    READ_TYPE(emgBands);
+    READ_TYPE(worldAccel);
+    READ_TYPE(linearAccel);
+    READ_TYPE(worldGyro);
+    READ_TYPE(gesture);
+    READ_TYPE(frame);
 #undef READ_TYPE
+    readEnvelopeSettings(val.get("emgEnvelope"), &out->envelope);
+    readBandSettings(val.get("emgBands"), &out->bands);
+    readGestureSettings(val.get("gesture"), &out->gestures);
+    readFrameSettings(val.get("frame"), &out->frames);
+    readOrientationFilterSettings(val.get("orientationFilter"), &out->orientationFilter);
+    readEulerSettings(val.get("euler"), &out->euler);
+    readCalibrationSettings(val.get("calibration"), &out->calibration);
+    readControlSettings(val.get("control"), &out->control);
+    readTimeTagSettings(val.get("timeTags"), &out->timeTags);
     std::cout << "reading other settings..." << std::endl;
     readBool(val.get("console"), &out->console);
     readBool(val.get("logOsc"), &out->logOsc);
     readString(val.get("host"), &out->hostname);
     readNumber(val.get("port"), &out->port);
+    readSendSettings(val.get("send"), &out->send);
+    readPacingSettings(val.get("pacing"), &out->pacing);
+    readBundleSettings(val.get("bundle"), &out->bundle);
+    readStatsSettings(val.get("stats"), &out->stats);
+    readHubSettings(val.get("hub"), &out->hub);
+    readRealtimeSettings(val.get("realtime"), &out->realtime);
   }
   
   static bool readSettingsChecked(const value& val, Settings* out) {
@@ -215,6 +700,46 @@ bool Settings::readJsonFile(const std::string& filename, Settings* settings) {
   return ok;
 }
 
+const char* outputIdName(OutputId id) {
+  switch (id) {
+    case OutputId::ACCEL: return "accel";
+    case OutputId::GYRO: return "gyro";
+    case OutputId::ORIENTATION: return "orientation";
+    case OutputId::ORIENTATION_QUAT: return "orientationQuat";
+    case OutputId::POSE: return "pose";
+    case OutputId::EMG: return "emg";
+    case OutputId::SYNC: return "sync";
+    case OutputId::RSSI: return "rssi";
+    case OutputId::EMG_ENVELOPE: return "emgEnvelope";
+    case OutputId::EMG_BANDS: return "emgBands";
+    case OutputId::WORLD_ACCEL: return "worldAccel";
+    case OutputId::LINEAR_ACCEL: return "linearAccel";
+    case OutputId::WORLD_GYRO: return "worldGyro";
+    case OutputId::GESTURE: return "gesture";
+    case OutputId::FRAME: return "frame";
+    default: return "unknown";
+  }
+}
+
+float outputSampleRate(OutputId id) {
+  switch (id) {
+    case OutputId::EMG:
+    case OutputId::EMG_ENVELOPE:
+    case OutputId::EMG_BANDS:
+      return 200;
+    case OutputId::ACCEL:
+    case OutputId::GYRO:
+    case OutputId::ORIENTATION:
+    case OutputId::ORIENTATION_QUAT:
+    case OutputId::WORLD_ACCEL:
+    case OutputId::LINEAR_ACCEL:
+    case OutputId::WORLD_GYRO:
+      return 50;
+    default:
+      return 0;
+  }
+}
+
 std::ostream& operator<<(std::ostream& os, const OutputType& type) {
   if (type.enabled)
     os << type.path;
@@ -227,6 +752,153 @@ std::ostream& operator<<(std::ostream& os, const OutputType& type) {
     if (type.scaling == Scaling::CLAMP)
       os << " (clamp)";
   }
+  if (type.enabled && type.priority == Priority::EVENT)
+    os << " (event)";
+  if (type.enabled && type.encoding == Encoding::HALF)
+    os << " (half)";
+  else if (type.enabled && type.encoding == Encoding::INT16)
+    os << " (int16)";
+  if (type.enabled && !type.filters.empty())
+    os << " (" << type.filters.size() << " filters)";
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const EnvelopeSettings& envelope) {
+  return os << "window " << envelope.window << ", cutoff " << envelope.cutoff << "Hz";
+}
+
+std::ostream& operator<<(std::ostream& os, const BandSettings& bands) {
+  os << "window " << bands.window << ", hop " << bands.hop << ", bands";
+  for (const auto& band : bands.bands)
+    os << " [" << band.low << ", " << band.high << "]";
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const FrameSettings& frame) {
+  static const char* names[] = { "orientation", "accel", "gyro", "emg", "rssi" };
+  os << frame.rate << "Hz, delay " << frame.delay << "ms,";
+  for (int i = 0; i < static_cast<int>(FrameStream::COUNT); ++i) {
+    if (frame.streams[i])
+      os << " " << names[i];
+  }
+  if (frame.format == FrameFormat::ARRAYS)
+    os << ", arrays of " << frame.batch;
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const OrientationFilterSettings& filter) {
+  switch (filter.smoothing) {
+    case Smoothing::EXPONENTIAL:
+      os << "exponential " << filter.alpha;
+      break;
+    case Smoothing::ONE_EURO:
+      os << "one-euro min cutoff " << filter.minCutoff << "Hz, beta " << filter.beta
+      << ", d cutoff " << filter.derivativeCutoff << "Hz";
+      break;
+    case Smoothing::NONE:
+    default:
+      os << "no smoothing";
+      break;
+  }
+  if (filter.predict > 0)
+    os << ", predict " << filter.predict << "ms";
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const EulerSettings& euler) {
+  for (int i = 0; i < 3; ++i)
+    os << static_cast<char>('x' + euler.axes[i]);
+  switch (euler.unit) {
+    case AngleUnit::DEGREES:
+      return os << " deg";
+    case AngleUnit::NORMALIZED:
+      return os << " normalized";
+    case AngleUnit::RADIANS:
+    default:
+      return os << " rad";
+  }
+}
+
+std::ostream& operator<<(std::ostream& os, const CalibrationSettings& calibration) {
+  os << (calibration.yawOnly ? "yaw only" : "full");
+  if (calibration.onSync)
+    os << ", on sync";
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const ControlSettings& control) {
+  if (!control.enabled)
+    return os << "(none)";
+  return os << "port " << control.port;
+}
+
+std::ostream& operator<<(std::ostream& os, const TimeTagSettings& timeTags) {
+  if (!timeTags.enabled)
+    return os << "(none)";
+  return os << "block " << timeTags.block << "ms, window " << timeTags.window << "s";
+}
+
+std::ostream& operator<<(std::ostream& os, const SendSettings& send) {
+  os << (send.nonBlocking ? "non-blocking" : "blocking");
+  if (send.bufferSize > 0)
+    os << ", buffer " << send.bufferSize;
+  return os << ", queue " << send.queueLength << ", drop "
+  << (send.dropPolicy == DropPolicy::DROP_OLDEST ? "oldest" : "newest");
+}
+
+std::ostream& operator<<(std::ostream& os, const PacingSettings& pacing) {
+  if (!pacing.enabled)
+    return os << "(none)";
+  return os << "delay " << pacing.delay << "ms, spin " << pacing.spin << "us, "
+  << pacing.capacity << " packets";
+}
+
+std::ostream& operator<<(std::ostream& os, const BundleSettings& bundle) {
+  if (!bundle.enabled)
+    return os << "(none)";
+  return os << "mtu " << bundle.mtu;
+}
+
+std::ostream& operator<<(std::ostream& os, const StatsSettings& stats) {
+  if (!stats.enabled)
+    return os << "(none)";
+  os << stats.hostname << ":" << stats.port << " every " << stats.interval << "ms";
+  if (!stats.file.empty())
+    os << ", json " << stats.file;
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const HubSettings& hub) {
+  os << (hub.runOnce ? "runOnce " : "run ") << hub.slice << "ms"
+  << ", rssi every " << hub.rssiInterval << "ms";
+  if (hub.keepAlive > 0)
+    os << ", keep-alive every " << hub.keepAlive << "ms";
+  return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const RealtimeSettings& realtime) {
+  switch (realtime.policy) {
+    case SchedPolicy::FIFO:
+      os << "fifo " << realtime.priority;
+      break;
+    case SchedPolicy::RR:
+      os << "rr " << realtime.priority;
+      break;
+    case SchedPolicy::DEFAULT:
+    default:
+      os << "default";
+      break;
+  }
+  if (realtime.hubCpu >= 0)
+    os << ", hub on cpu " << realtime.hubCpu;
+  if (realtime.timerCpu >= 0)
+    os << ", timer on cpu " << realtime.timerCpu;
+  if (realtime.pacerCpu >= 0)
+    os << ", pacer on cpu " << realtime.pacerCpu;
+  if (realtime.lockMemory)
+    os << ", locked";
+  if (realtime.prefault)
+    os << ", prefault";
   return os;
 }
 
@@ -235,6 +907,12 @@ std::ostream& operator<<(std::ostream& os, const Settings& settings) {
   return os << std::boolalpha << "Settings<\n"
   << "  hostname: " << settings.hostname << "\n"
   << "  port: " << settings.port << "\n"
+  << "  send: " << settings.send << "\n"
+  << "  pacing: " << settings.pacing << "\n"
+  << "  bundle: " << settings.bundle << "\n"
+  << "  stats: " << settings.stats << "\n"
+  << "  hub: " << settings.hub << "\n"
+  << "  realtime: " << settings.realtime << "\n"
   << "  accel: " << settings.accel << "\n"
   << "  gyro: " << settings.gyro << "\n"
   << "  orientation: " << settings.orientation << "\n"
@@ -242,6 +920,18 @@ std::ostream& operator<<(std::ostream& os, const Settings& settings) {
   << "  emg: " << settings.emg << "\n"
   << "  sync: " << settings.sync << "\n"
   << "  rssi: " << settings.rssi << "\n"
+  << "  emgEnvelope: " << settings.emgEnvelope << ", " << settings.envelope << "\n"
+  << "  emgBands: " << settings.emgBands << ", " << settings.bands << "\n"
+  << "  worldAccel: " << settings.worldAccel << "\n"
+  << "  linearAccel: " << settings.linearAccel << "\n"
+  << "  worldGyro: " << settings.worldGyro << "\n"
+  << "  gesture: " << settings.gesture << ", " << settings.gestures << "\n"
+  << "  frame: " << settings.frame << ", " << settings.frames << "\n"
+  << "  orientationFilter: " << settings.orientationFilter << "\n"
+  << "  euler: " << settings.euler << "\n"
+  << "  calibration: " << settings.calibration << "\n"
+  << "  control: " << settings.control << "\n"
+  << "  timeTags: " << settings.timeTags << "\n"
   << "  console: " << settings.console << "\n"
   << ">\n";
 }
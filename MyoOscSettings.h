@@ -1,12 +1,17 @@
 // MyoOscSettings.h
 
 #ifndef __MYO_OSC_SETTINGS_H__
+#define __MYO_OSC_SETTINGS_H__
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <myo/myo.hpp>
 
+#include "MyoOscFilter.h"
+#include "MyoOscGesture.h"
+
 struct Range {
   float min;
   float max;
@@ -19,29 +24,370 @@ enum class Scaling {
   CLAMP
 };
 
+// how float outputs go on the wire: one float argument per value, or all
+// the values packed into a blob of big-endian 16 bit words, as IEEE half
+// floats or as int16 spanning the output's range
+enum class Encoding {
+  FLOAT,
+  HALF,
+  INT16
+};
+
+// discrete events (pose, sync) are kept in preference to continuous
+// streams when the send queue overflows
+enum class Priority {
+  STREAM,
+  EVENT
+};
+
+// which packet to give up when the send queue is full
+enum class DropPolicy {
+  DROP_OLDEST,
+  DROP_NEWEST
+};
+
+// scheduling class for the hub and timer threads
+enum class SchedPolicy {
+  DEFAULT,
+  FIFO,
+  RR
+};
+
+// identifies each output type, e.g. for per-type statistics
+enum class OutputId {
+  ACCEL,
+  GYRO,
+  ORIENTATION,
+  ORIENTATION_QUAT,
+  POSE,
+  EMG,
+  SYNC,
+  RSSI,
+  EMG_ENVELOPE,
+  EMG_BANDS,
+  WORLD_ACCEL,
+  LINEAR_ACCEL,
+  WORLD_GYRO,
+  GESTURE,
+  FRAME,
+  COUNT
+};
+
+const char* outputIdName(OutputId id);
+
+// samples per second libmyo delivers for an output, 0 if it isn't periodic
+float outputSampleRate(OutputId id);
+
 struct OutputType {
   
+  OutputId id;
   bool enabled;
   std::string path;
   Range inrange;
   Range outrange;
   Scaling scaling;
+  Priority priority;
+  Encoding encoding;
+  // filter cascade from the config, and its coefficients for this output's
+  // sample rate
+  std::vector<FilterSpec> filters;
+  std::vector<Biquad> biquads;
   
   OutputType()
-  : enabled(false), path("")
+  : id(OutputId::COUNT)
+  , enabled(false), path("")
   , scaling(Scaling::NONE)
-  , inrange(), outrange() { }
+  , inrange(), outrange()
+  , priority(Priority::STREAM)
+  , encoding(Encoding::FLOAT) { }
   
-  OutputType(bool en, std::string p)
-  : enabled(en), path(p)
+  OutputType(OutputId i, bool en, std::string p, Priority prio = Priority::STREAM)
+  : id(i)
+  , enabled(en), path(p)
   , scaling(Scaling::NONE)
-  , inrange(), outrange() { }
+  , inrange(), outrange()
+  , priority(prio)
+  , encoding(Encoding::FLOAT) { }
   
   operator bool() const { return enabled; }
 };
 
 std::ostream& operator<<(std::ostream& os, const OutputType& type);
 
+// parameters for the emgEnvelope output, read from its JSON object
+struct EnvelopeSettings {
+  // moving RMS window in samples (EMG arrives at 200Hz per channel)
+  int window;
+  // cutoff of the low-pass applied to the rectified signal, in Hz
+  float cutoff;
+  
+  EnvelopeSettings() : window(40), cutoff(5) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const EnvelopeSettings& envelope);
+
+struct FrequencyBand {
+  float low;
+  float high;
+};
+
+#define EMG_MAX_BANDS 8
+
+// parameters for the emgBands output, read from its JSON object
+struct BandSettings {
+  // DFT length in samples
+  int window;
+  // samples between messages
+  int hop;
+  // [low, high) in Hz, at most EMG_MAX_BANDS
+  std::vector<FrequencyBand> bands;
+  
+  BandSettings() : window(64), hop(16) {
+    FrequencyBand defaults[] = { {10, 30}, {30, 60}, {60, 100} };
+    bands.assign(defaults, defaults + 3);
+  }
+};
+
+std::ostream& operator<<(std::ostream& os, const BandSettings& bands);
+
+// the sensor streams that can go into a resampled frame, in frame order
+enum class FrameStream {
+  // calibrated orientation quaternion, x y z w
+  ORIENTATION,
+  ACCEL,
+  GYRO,
+  EMG,
+  RSSI,
+  COUNT
+};
+
+// how frames are laid out in a message
+enum class FrameFormat {
+  // one frame per message, its timestamp then every value
+  FLAT,
+  // a frame count, the first frame's timestamp, then each frame as an OSC
+  // array
+  ARRAYS
+};
+
+// most frames in one arrays message
+#define FRAME_MAX_BATCH 64
+
+// parameters for the frame output, read from its JSON object
+struct FrameSettings {
+  // output clock in Hz
+  float rate;
+  // how far behind the newest sample each frame is taken, in ms. needs to
+  // cover the slowest included stream's sample interval plus jitter.
+  float delay;
+  bool streams[static_cast<int>(FrameStream::COUNT)];
+  FrameFormat format;
+  // frames per message, only with ARRAYS. fewer go if more won't fit.
+  int batch;
+  
+  FrameSettings() : rate(100), delay(50), format(FrameFormat::FLAT), batch(1) {
+    for (auto& stream : streams)
+      stream = true;
+    streams[static_cast<int>(FrameStream::RSSI)] = false;
+  }
+  
+  bool includes(FrameStream stream) const { return streams[static_cast<int>(stream)]; }
+};
+
+std::ostream& operator<<(std::ostream& os, const FrameSettings& frame);
+
+enum class Smoothing {
+  NONE,
+  // slerp toward each new sample by a fixed factor
+  EXPONENTIAL,
+  // one-euro filter: the cutoff rises with angular speed, so slow
+  // movement is smoothed hard and fast movement lags little
+  ONE_EURO
+};
+
+// applies to both the orientation and orientationQuat outputs
+struct OrientationFilterSettings {
+  Smoothing smoothing;
+  // EXPONENTIAL: fraction of the way to move toward each new sample
+  float alpha;
+  // ONE_EURO parameters, cutoffs in Hz and beta per rad/s
+  float minCutoff;
+  float beta;
+  float derivativeCutoff;
+  // extrapolate this many ms ahead at the gyro's angular velocity, 0 is off
+  float predict;
+  
+  OrientationFilterSettings()
+  : smoothing(Smoothing::NONE), alpha(0.5f)
+  , minCutoff(1.0f), beta(0.5f), derivativeCutoff(1.0f)
+  , predict(0) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const OrientationFilterSettings& filter);
+
+enum class AngleUnit {
+  RADIANS,
+  DEGREES,
+  // fractions of half a turn, so -1 to 1
+  NORMALIZED
+};
+
+// how the orientation output turns a quaternion into angles
+struct EulerSettings {
+  // rotation axes (0 = x, 1 = y, 2 = z) in intrinsic order; the output
+  // angles follow the same order. the default z-y-x gives yaw, pitch, roll.
+  int axes[3];
+  AngleUnit unit;
+  
+  EulerSettings() : unit(AngleUnit::RADIANS) {
+    axes[0] = 2;
+    axes[1] = 1;
+    axes[2] = 0;
+  }
+};
+
+std::ostream& operator<<(std::ostream& os, const EulerSettings& euler);
+
+// reference orientation that the orientation outputs are reported against
+struct CalibrationSettings {
+  // take the current orientation as the reference on arm sync
+  bool onSync;
+  // only take the heading (rotation about world z) from the reference, so
+  // "forward" is reset while up stays up
+  bool yawOnly;
+  
+  CalibrationSettings() : onSync(false), yawOnly(true) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const CalibrationSettings& calibration);
+
+// inbound OSC commands, e.g. /myo-osc/calibrate
+struct ControlSettings {
+  bool enabled;
+  int port;
+  
+  ControlSettings() : enabled(false), port(7779) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const ControlSettings& control);
+
+// sends every message in a bundle time-tagged with when libmyo sampled it
+struct TimeTagSettings {
+  bool enabled;
+  // the earliest arrival in each block of this many ms is used to estimate
+  // the offset between the Myo's clock and the host's
+  int block;
+  // seconds over which older estimates fade out of the drift fit
+  float window;
+  
+  TimeTagSettings() : enabled(false), block(1000), window(60) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const TimeTagSettings& timeTags);
+
+struct SendSettings {
+  // use a non-blocking socket so a full send buffer never stalls the
+  // libmyo callback thread
+  bool nonBlocking;
+  // SO_SNDBUF in bytes, 0 leaves the system default
+  int bufferSize;
+  // number of packets held back while the socket is full
+  int queueLength;
+  DropPolicy dropPolicy;
+  
+  SendSettings()
+  : nonBlocking(false), bufferSize(0)
+  , queueLength(16), dropPolicy(DropPolicy::DROP_OLDEST) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const SendSettings& send);
+
+// holds each packet until the time its event was sampled plus a fixed
+// delay, then sends it from a thread of its own
+struct PacingSettings {
+  bool enabled;
+  // ms between an event being sampled and its packets being sent. needs to
+  // be longer than libmyo's delivery clumps.
+  float delay;
+  // the sleep ends this many microseconds early and busy-waits the rest
+  int spin;
+  // packets held at once
+  int capacity;
+  
+  PacingSettings() : enabled(false), delay(40), spin(200), capacity(128) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const PacingSettings& pacing);
+
+// packs the messages of each libmyo event into one bundle per datagram
+struct BundleSettings {
+  bool enabled;
+  // path MTU in bytes, 9000 for jumbo frames. a bundle stops growing before
+  // its datagram would need fragmenting.
+  int mtu;
+  
+  BundleSettings() : enabled(false), mtu(1500) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const BundleSettings& bundle);
+
+struct StatsSettings {
+  bool enabled;
+  // destination for the periodic /myo-osc/stats/... messages
+  std::string hostname;
+  int port;
+  // publish interval in milliseconds
+  int interval;
+  // if set, a JSON dump of the counters is written here on every publish
+  std::string file;
+  
+  StatsSettings()
+  : enabled(false), hostname("127.0.0.1")
+  , port(7778), interval(1000), file("") { }
+};
+
+std::ostream& operator<<(std::ostream& os, const StatsSettings& stats);
+
+struct HubSettings {
+  // duration of each hub.run()/runOnce() call in milliseconds
+  int slice;
+  // use hub.runOnce(), which returns after the first event instead of
+  // pumping for the whole slice
+  bool runOnce;
+  // how often to ask for RSSI when rssi output is enabled, in ms
+  int rssiInterval;
+  // interval for /myo-osc/alive heartbeat messages, 0 disables them
+  int keepAlive;
+  
+  HubSettings()
+  : slice(1000/20), runOnce(false)
+  , rssiInterval(1000/20), keepAlive(0) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const HubSettings& hub);
+
+struct RealtimeSettings {
+  SchedPolicy policy;
+  // priority within the policy, ignored for SchedPolicy::DEFAULT
+  int priority;
+  // core to pin each thread to, -1 leaves it to the scheduler. packets are
+  // sent from the libmyo callbacks, so the hub thread is also the sender.
+  int hubCpu;
+  int timerCpu;
+  int pacerCpu;
+  // mlockall() the process so it's never paged out
+  bool lockMemory;
+  // touch send buffers, queues and thread stacks at startup
+  bool prefault;
+  
+  RealtimeSettings()
+  : policy(SchedPolicy::DEFAULT), priority(0)
+  , hubCpu(-1), timerCpu(-1), pacerCpu(-1)
+  , lockMemory(false), prefault(false) { }
+};
+
+std::ostream& operator<<(std::ostream& os, const RealtimeSettings& realtime);
+
 struct Settings {
   OutputType accel;
   OutputType gyro;
@@ -51,6 +397,25 @@ struct Settings {
   OutputType emg;
   OutputType sync;
   OutputType rssi;
+  OutputType emgEnvelope;
+  OutputType emgBands;
+  // derived from the orientation event: accel and gyro rotated into the
+  // world frame, and world accel with gravity removed
+  OutputType worldAccel;
+  OutputType linearAccel;
+  OutputType worldGyro;
+  // custom gestures recognized by the gesture model
+  OutputType gesture;
+  // every included stream resampled onto one clock, one message per tick
+  OutputType frame;
+  
+  EnvelopeSettings envelope;
+  BandSettings bands;
+  GestureSettings gestures;
+  FrameSettings frames;
+  OrientationFilterSettings orientationFilter;
+  EulerSettings euler;
+  CalibrationSettings calibration;
   
   bool console;
   bool logOsc;
@@ -58,6 +423,15 @@ struct Settings {
   std::string hostname;
   int port;
   
+  SendSettings send;
+  PacingSettings pacing;
+  BundleSettings bundle;
+  StatsSettings stats;
+  HubSettings hub;
+  RealtimeSettings realtime;
+  ControlSettings control;
+  TimeTagSettings timeTags;
+  
   static bool readJson(std::istream& input, Settings* settings);
   static bool readJson(const std::string& jsonText, Settings* settings);
   static bool readJsonFile(const std::string& filename, Settings* settings);
@@ -0,0 +1,33 @@
+// MyoOscSimd.h
+//
+// Picks the SIMD instruction set the DSP code can assume: SSE on x86 (always
+// there on x86-64), NEON on ARM. Code using these should keep a scalar
+// fallback for when neither is defined.
+
+#ifndef __MYO_OSC_SIMD_H__
+#define __MYO_OSC_SIMD_H__
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MYO_OSC_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MYO_OSC_NEON
+#endif
+
+// SSE2's integer conversions and shuffles, also always there on x86-64
+#if defined(MYO_OSC_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define MYO_OSC_SSE2
+#endif
+
+// hardware float to half conversion: F16C on x86 when the compiler targets
+// it (-mf16c), NEON on AArch64 and ARMv7 with the fp16 extension
+#if defined(MYO_OSC_SSE) && defined(__F16C__)
+#include <immintrin.h>
+#define MYO_OSC_F16C
+#elif defined(MYO_OSC_NEON) && (defined(__aarch64__) || (defined(__ARM_FP) && (__ARM_FP & 2)))
+#define MYO_OSC_NEON_FP16
+#endif
+
+#endif // __MYO_OSC_SIMD_H__
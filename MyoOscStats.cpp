@@ -0,0 +1,179 @@
+// MyoOscStats.cpp
+
+#include "MyoOscStats.h"
+
+#include "picojson.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+Stats::Stats()
+: slices_(0), sliceMicros_(0), sliceMaxMicros_(0) { }
+
+void Stats::countMyoEvent(const void* myo) {
+  for (int i = 0; i < STATS_MAX_MYOS; ++i) {
+    const void* current = myos_[i].myo.load(std::memory_order_relaxed);
+    if (current == nullptr) {
+      // claim the slot, unless someone beat us to it with a different Myo
+      if (!myos_[i].myo.compare_exchange_strong(current, myo, std::memory_order_relaxed) &&
+          current != myo)
+        continue;
+      current = myo;
+    }
+    if (current == myo) {
+      myos_[i].events.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+
+void Stats::recordSlice(uint64_t micros) {
+  slices_.fetch_add(1, std::memory_order_relaxed);
+  sliceMicros_.fetch_add(micros, std::memory_order_relaxed);
+  // single writer, so a plain compare and store is enough
+  if (micros > sliceMaxMicros_.load(std::memory_order_relaxed))
+    sliceMaxMicros_.store(micros, std::memory_order_relaxed);
+}
+
+StatsPublisher::StatsPublisher(Stats& stats, const SendCounters& sender,
+                               const StatsSettings& settings)
+: stats_(stats)
+, sender_(sender)
+, settings_(settings)
+, socket_(nullptr)
+, lastPublish_(std::chrono::steady_clock::now())
+, lastSlices_(0), lastSliceMicros_(0)
+, lastSent_(0), lastDropped_(0), lastErrored_(0)
+{
+  socket_ = new UdpTransmitSocket(IpEndpointName(settings_.hostname.c_str(), settings_.port));
+  for (auto& last : lastOutputs_)
+    last = OutputSnapshot();
+  for (auto& last : lastMyoEvents_)
+    last = 0;
+}
+
+StatsPublisher::~StatsPublisher() {
+  if (socket_ != nullptr) {
+    delete socket_;
+  }
+}
+
+static int32_t delta(uint64_t current, uint64_t* last) {
+  uint64_t d = current - *last;
+  *last = current;
+  return static_cast<int32_t>(d);
+}
+
+void StatsPublisher::publish() {
+  auto now = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(now - lastPublish_).count();
+  lastPublish_ = now;
+  std::string prefix = "/myo-osc/stats/";
+
+  // per output type, counts since the previous publish
+  for (int i = 0; i < static_cast<int>(OutputId::COUNT); ++i) {
+    const OutputStats& out = stats_.output(static_cast<OutputId>(i));
+    OutputSnapshot& last = lastOutputs_[i];
+    osc::OutboundPacketStream p(buffer_, sizeof(buffer_));
+    p << osc::BeginMessage((prefix + "output/" + outputIdName(static_cast<OutputId>(i))).c_str())
+    << delta(out.eventsIn.load(std::memory_order_relaxed), &last.eventsIn)
+    << delta(out.messagesOut.load(std::memory_order_relaxed), &last.messagesOut)
+    << delta(out.bytesOut.load(std::memory_order_relaxed), &last.bytesOut)
+    << delta(out.drops.load(std::memory_order_relaxed), &last.drops)
+    << delta(out.clamps.load(std::memory_order_relaxed), &last.clamps)
+    << osc::EndMessage;
+    socket_->TrySend(p.Data(), p.Size());
+  }
+
+  {
+    osc::OutboundPacketStream p(buffer_, sizeof(buffer_));
+    p << osc::BeginMessage((prefix + "sender").c_str())
+    << delta(sender_.sent.load(std::memory_order_relaxed), &lastSent_)
+    << delta(sender_.dropped.load(std::memory_order_relaxed), &lastDropped_)
+    << delta(sender_.errored.load(std::memory_order_relaxed), &lastErrored_)
+    << osc::EndMessage;
+    socket_->TrySend(p.Data(), p.Size());
+  }
+
+  for (int i = 0; i < STATS_MAX_MYOS; ++i) {
+    if (stats_.myos_[i].myo.load(std::memory_order_relaxed) == nullptr)
+      break;
+    int32_t events = delta(stats_.myos_[i].events.load(std::memory_order_relaxed), &lastMyoEvents_[i]);
+    osc::OutboundPacketStream p(buffer_, sizeof(buffer_));
+    p << osc::BeginMessage((prefix + "myo").c_str())
+    << static_cast<int32_t>(i)
+    << static_cast<float>(seconds > 0 ? events / seconds : 0)
+    << osc::EndMessage;
+    socket_->TrySend(p.Data(), p.Size());
+  }
+
+  {
+    int32_t slices = delta(stats_.slices_.load(std::memory_order_relaxed), &lastSlices_);
+    int32_t micros = delta(stats_.sliceMicros_.load(std::memory_order_relaxed), &lastSliceMicros_);
+    uint64_t maxMicros = stats_.sliceMaxMicros_.exchange(0, std::memory_order_relaxed);
+    osc::OutboundPacketStream p(buffer_, sizeof(buffer_));
+    p << osc::BeginMessage((prefix + "hub").c_str())
+    << slices
+    << static_cast<float>(slices ? micros / 1000.0 / slices : 0)
+    << static_cast<float>(maxMicros / 1000.0)
+    << osc::EndMessage;
+    socket_->TrySend(p.Data(), p.Size());
+  }
+
+  if (!settings_.file.empty()) {
+    // write then rename, so readers never see a partial file
+    std::string tempFile = settings_.file + ".tmp";
+    std::ofstream out(tempFile);
+    if (out.good()) {
+      out << toJson();
+      out.close();
+      if (std::rename(tempFile.c_str(), settings_.file.c_str()) != 0)
+        std::cerr << "Unable to write stats file " << settings_.file << std::endl;
+    }
+  }
+}
+
+static picojson::value number(uint64_t value) {
+  return picojson::value(static_cast<double>(value));
+}
+
+std::string StatsPublisher::toJson() const {
+  picojson::object outputs;
+  for (int i = 0; i < static_cast<int>(OutputId::COUNT); ++i) {
+    const OutputStats& out = stats_.output(static_cast<OutputId>(i));
+    picojson::object obj;
+    obj["eventsIn"] = number(out.eventsIn.load(std::memory_order_relaxed));
+    obj["messagesOut"] = number(out.messagesOut.load(std::memory_order_relaxed));
+    obj["bytesOut"] = number(out.bytesOut.load(std::memory_order_relaxed));
+    obj["drops"] = number(out.drops.load(std::memory_order_relaxed));
+    obj["clamps"] = number(out.clamps.load(std::memory_order_relaxed));
+    outputs[outputIdName(static_cast<OutputId>(i))] = picojson::value(obj);
+  }
+
+  picojson::object sender;
+  sender["sent"] = number(sender_.sent.load(std::memory_order_relaxed));
+  sender["dropped"] = number(sender_.dropped.load(std::memory_order_relaxed));
+  sender["errored"] = number(sender_.errored.load(std::memory_order_relaxed));
+
+  picojson::array myos;
+  for (int i = 0; i < STATS_MAX_MYOS; ++i) {
+    if (stats_.myos_[i].myo.load(std::memory_order_relaxed) == nullptr)
+      break;
+    picojson::object obj;
+    obj["index"] = number(i);
+    obj["events"] = number(stats_.myos_[i].events.load(std::memory_order_relaxed));
+    myos.push_back(picojson::value(obj));
+  }
+
+  picojson::object hub;
+  hub["slices"] = number(stats_.slices_.load(std::memory_order_relaxed));
+  hub["totalMicros"] = number(stats_.sliceMicros_.load(std::memory_order_relaxed));
+
+  picojson::object root;
+  root["outputs"] = picojson::value(outputs);
+  root["sender"] = picojson::value(sender);
+  root["myos"] = picojson::value(myos);
+  root["hub"] = picojson::value(hub);
+  return picojson::value(root).serialize();
+}
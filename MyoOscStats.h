@@ -0,0 +1,123 @@
+// MyoOscStats.h
+//
+// Runtime counters for myo-osc. Everything updated from the libmyo callback
+// path is a relaxed atomic, so recording costs a handful of uncontended
+// increments; reading happens on whatever thread publishes the stats.
+
+#ifndef __MYO_OSC_STATS_H__
+#define __MYO_OSC_STATS_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "osc/OscOutboundPacketStream.h"
+#include "ip/UdpSocket.h"
+
+#include "MyoOscSettings.h"
+#include "MyoOscSender.h"
+
+#define STATS_MAX_MYOS 4
+
+struct OutputStats {
+  // libmyo callbacks for the output's own sensor stream, whether or not it's
+  // enabled. outputs derived from other streams (world and linear accel,
+  // world gyro, orientationQuat, the EMG features, gesture and frame) count
+  // the input events they consume, and only while enabled.
+  std::atomic<uint64_t> eventsIn;
+  std::atomic<uint64_t> messagesOut;
+  std::atomic<uint64_t> bytesOut;
+  std::atomic<uint64_t> drops;
+  std::atomic<uint64_t> clamps;
+
+  OutputStats() : eventsIn(0), messagesOut(0), bytesOut(0), drops(0), clamps(0) { }
+};
+
+class Stats {
+public:
+  Stats();
+
+  OutputStats& output(OutputId id) {
+    return outputs_[id < OutputId::COUNT ? static_cast<int>(id) : static_cast<int>(OutputId::COUNT)];
+  }
+
+  void countEvent(OutputId id) {
+    output(id).eventsIn.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void countMessage(OutputId id, std::size_t bytes) {
+    OutputStats& out = output(id);
+    out.messagesOut.fetch_add(1, std::memory_order_relaxed);
+    out.bytesOut.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void countDrop(OutputId id) {
+    output(id).drops.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void countClamps(OutputId id, unsigned clamps) {
+    if (clamps)
+      output(id).clamps.fetch_add(clamps, std::memory_order_relaxed);
+  }
+
+  // counts an event from a particular Myo. the first STATS_MAX_MYOS devices
+  // seen get their own slot, any further ones are ignored.
+  void countMyoEvent(const void* myo);
+
+  // records how long one hub.run() slice took
+  void recordSlice(uint64_t micros);
+
+private:
+  friend class StatsPublisher;
+
+  struct MyoSlot {
+    std::atomic<const void*> myo;
+    std::atomic<uint64_t> events;
+
+    MyoSlot() : myo(nullptr), events(0) { }
+  };
+
+  // one extra slot absorbs events for OutputId::COUNT
+  OutputStats outputs_[static_cast<int>(OutputId::COUNT) + 1];
+  MyoSlot myos_[STATS_MAX_MYOS];
+
+  std::atomic<uint64_t> slices_;
+  std::atomic<uint64_t> sliceMicros_;
+  std::atomic<uint64_t> sliceMaxMicros_;
+};
+
+// Publishes a Stats instance as OSC messages under /myo-osc/stats/ and
+// optionally as a JSON file. Not thread safe, call publish() from one thread.
+class StatsPublisher {
+public:
+  StatsPublisher(Stats& stats, const SendCounters& sender,
+                 const StatsSettings& settings);
+  ~StatsPublisher();
+
+  void publish();
+
+  // cumulative counters as a JSON document
+  std::string toJson() const;
+
+private:
+  struct OutputSnapshot {
+    uint64_t eventsIn, messagesOut, bytesOut, drops, clamps;
+  };
+
+  Stats& stats_;
+  const SendCounters& sender_;
+  StatsSettings settings_;
+  UdpTransmitSocket* socket_;
+  char buffer_[1024];
+
+  std::chrono::steady_clock::time_point lastPublish_;
+  OutputSnapshot lastOutputs_[static_cast<int>(OutputId::COUNT)];
+  uint64_t lastMyoEvents_[STATS_MAX_MYOS];
+  uint64_t lastSlices_;
+  uint64_t lastSliceMicros_;
+  uint64_t lastSent_, lastDropped_, lastErrored_;
+};
+
+#endif // __MYO_OSC_STATS_H__
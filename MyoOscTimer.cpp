@@ -0,0 +1,74 @@
+// MyoOscTimer.cpp
+
+#include "MyoOscTimer.h"
+
+#include <exception>
+#include <iostream>
+
+TimerThread::TimerThread()
+: stopping_(false) { }
+
+TimerThread::~TimerThread() {
+  stop();
+}
+
+void TimerThread::add(int intervalMs, std::function<void()> task) {
+  if (intervalMs <= 0)
+    return;
+  Task t;
+  t.interval = std::chrono::milliseconds(intervalMs);
+  t.run = task;
+  tasks_.push_back(t);
+}
+
+void TimerThread::start() {
+  if (tasks_.empty())
+    return;
+  auto now = Clock::now();
+  for (auto& task : tasks_)
+    task.due = now + task.interval;
+  stopping_ = false;
+  thread_ = std::thread(&TimerThread::run, this);
+}
+
+void TimerThread::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (thread_.joinable())
+    thread_.join();
+}
+
+void TimerThread::run() {
+  if (init_)
+    init_();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    Clock::time_point next = tasks_.front().due;
+    for (const auto& task : tasks_) {
+      if (task.due < next)
+        next = task.due;
+    }
+    if (wake_.wait_until(lock, next, [this] { return stopping_; }))
+      break;
+
+    auto now = Clock::now();
+    lock.unlock();
+    for (auto& task : tasks_) {
+      if (task.due > now)
+        continue;
+      try {
+        task.run();
+      } catch (const std::exception& e) {
+        std::cerr << "Error in timer task: " << e.what() << std::endl;
+      }
+      // skip missed periods rather than running a task several times in a row
+      do {
+        task.due += task.interval;
+      } while (task.due <= now);
+    }
+    lock.lock();
+  }
+}
@@ -0,0 +1,53 @@
+// MyoOscTimer.h
+//
+// Runs periodic housekeeping tasks (RSSI polling, stats, keep-alives) on a
+// thread of their own, so their timing doesn't depend on how long each
+// hub.run() slice takes.
+
+#ifndef __MYO_OSC_TIMER_H__
+#define __MYO_OSC_TIMER_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TimerThread {
+public:
+  TimerThread();
+  ~TimerThread();
+
+  // only call add() before start(). tasks with an interval <= 0 are ignored.
+  void add(int intervalMs, std::function<void()> task);
+
+  // called on the timer thread before any task runs, e.g. to set its
+  // scheduling. must be set before start().
+  void setThreadInit(std::function<void()> init) { init_ = init; }
+
+  void start();
+
+  // wakes the thread and waits for it to exit
+  void stop();
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Task {
+    Clock::duration interval;
+    Clock::time_point due;
+    std::function<void()> run;
+  };
+
+  void run();
+
+  std::vector<Task> tasks_;
+  std::function<void()> init_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_;
+};
+
+#endif // __MYO_OSC_TIMER_H__
@@ -0,0 +1,77 @@
+// bench.h
+//
+// Shared by the benchmarks in this directory. Timings are the best of
+// several runs, which is the figure least disturbed by whatever else the
+// machine is doing; keep() stops the compiler dropping work whose result
+// is otherwise unused.
+
+#ifndef __MYO_OSC_BENCH_H__
+#define __MYO_OSC_BENCH_H__
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#define BENCH_RUNS 7
+
+template <typename T>
+inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+
+// nanoseconds per call of fn(i) for i in [0, iterations)
+template <typename F>
+double nanosPer(long iterations, F fn) {
+  double best = 1e300;
+  for (int run = 0; run < BENCH_RUNS; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i)
+      fn(i);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count() / iterations);
+  }
+  return best;
+}
+
+inline int64_t nowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// deviation of the gaps between arrival times (us) from their mean
+struct Jitter {
+  double mean;
+  double stddev;
+  double p99;
+  double max;
+
+  explicit Jitter(const std::vector<int64_t>& arrivals)
+  : mean(0), stddev(0), p99(0), max(0) {
+    std::vector<double> gaps;
+    for (std::size_t i = 1; i < arrivals.size(); ++i)
+      gaps.push_back(static_cast<double>(arrivals[i] - arrivals[i - 1]));
+    if (gaps.empty())
+      return;
+    for (double gap : gaps)
+      mean += gap;
+    mean /= gaps.size();
+    std::vector<double> deviations;
+    for (double gap : gaps) {
+      stddev += (gap - mean) * (gap - mean);
+      deviations.push_back(std::fabs(gap - mean));
+    }
+    stddev = std::sqrt(stddev / gaps.size());
+    std::sort(deviations.begin(), deviations.end());
+    p99 = deviations[deviations.size() * 99 / 100];
+    max = deviations.back();
+  }
+};
+
+#endif // __MYO_OSC_BENCH_H__
@@ -0,0 +1,125 @@
+// bundle_bench.cpp
+//
+// Messages per second sent over loopback one datagram per message, against
+// packed into MTU-sized bundles by BundleBuilder at 1500 and 9000 bytes.
+// The messages are the generator's 4-float orientation. A receiver thread
+// counts what arrives, so the rates can be checked against what got
+// through.
+//
+// built from this directory with the Myo SDK's include directory:
+//   g++ -std=gnu++11 -O2 -pthread -I.. -I../libs -I<Myo SDK>/include bundle_bench.cpp
+//     ../MyoOscBundle.cpp ../MyoOscSender.cpp ../MyoOscStats.cpp ../MyoOscSettings.cpp
+//     ../MyoOscFilter.cpp ../MyoOscGesture.cpp ../osc/OscOutboundPacketStream.cpp
+//     ../osc/OscReceivedElements.cpp ../osc/OscTypes.cpp
+//     ../ip/IpEndpointName.cpp ../ip/posix/NetworkingUtils.cpp ../ip/posix/UdpSocket.cpp
+// takes the number of messages per run (default 1000000).
+
+#include "bench.h"
+
+#include "MyoOscBundle.h"
+#include "MyoOscSender.h"
+#include "ip/UdpSocket.h"
+#include "osc/OscReceivedElements.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#define BENCH_PORT 47122
+#define ADDRESS "/myo/orientation"
+
+// counts the messages arriving at the benchmark port until told to stop
+class Receiver {
+public:
+  Receiver() : socket_(IpEndpointName("127.0.0.1", BENCH_PORT)), messages_(0), done_(false) {
+    thread_ = std::thread([this] { run(); });
+  }
+
+  // waits for the socket to drain, then stops the thread
+  long stop() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    UdpTransmitSocket out(IpEndpointName("127.0.0.1", BENCH_PORT));
+    while (!done_) {
+      out.Send("stop", 4);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    thread_.join();
+    return messages_;
+  }
+
+private:
+  void run() {
+    std::vector<char> data(65536);
+    IpEndpointName from;
+    for (;;) {
+      std::size_t size = socket_.ReceiveFrom(from, &data[0], data.size());
+      if (size == 4 && std::memcmp(&data[0], "stop", 4) == 0)
+        break;
+      osc::ReceivedPacket packet(&data[0], size);
+      if (packet.IsBundle())
+        messages_ += osc::ReceivedBundle(packet).ElementCount();
+      else
+        ++messages_;
+    }
+    done_ = true;
+  }
+
+  UdpReceiveSocket socket_;
+  long messages_;
+  std::atomic<bool> done_;
+  std::thread thread_;
+};
+
+static void report(const char* name, long sent, std::chrono::steady_clock::duration elapsed, long received) {
+  double seconds = std::chrono::duration<double>(elapsed).count();
+  std::printf("%-14s %8.2f M msg/s, %5.1f%% received\n", name, sent / seconds / 1e6, 100.0 * received / sent);
+}
+
+int main(int argc, char** argv) {
+  long messages = argc > 1 ? std::atol(argv[1]) : 1000000;
+  OscSender sender("127.0.0.1", BENCH_PORT, SendSettings(), nullptr, 9000);
+
+  {
+    Receiver receiver;
+    char buffer[256];
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < messages; ++i) {
+      osc::OutboundPacketStream p(buffer, sizeof(buffer));
+      p.WriteMessage(ADDRESS, 1.0f, 2.0f, 3.0f, static_cast<float>(i));
+      sender.send(p.Data(), p.Size(), OutputId::ORIENTATION, Priority::STREAM);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    report("per message", messages, elapsed, receiver.stop());
+  }
+
+  const int mtus[] = { 1500, 9000 };
+  for (int mtu : mtus) {
+    BundleSettings settings;
+    settings.enabled = true;
+    settings.mtu = mtu;
+    BundleBuilder bundler(settings);
+    std::size_t messageSize = bundledMessageSize(std::strlen(ADDRESS), 4, 16);
+
+    Receiver receiver;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < messages; ++i) {
+      if (!bundler.fits(messageSize)) {
+        std::size_t size = bundler.finish();
+        sender.send(bundler.data(), size, bundler.id(), bundler.priority());
+      }
+      bundler.begin(0, 1).WriteMessage(ADDRESS, 1.0f, 2.0f, 3.0f, static_cast<float>(i));
+      bundler.added(OutputId::ORIENTATION, Priority::STREAM);
+    }
+    if (!bundler.empty()) {
+      std::size_t size = bundler.finish();
+      sender.send(bundler.data(), size, bundler.id(), bundler.priority());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    char name[32];
+    std::snprintf(name, sizeof(name), "bundled, %d", mtu);
+    report(name, messages, elapsed, receiver.stop());
+  }
+  return 0;
+}
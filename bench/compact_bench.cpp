@@ -0,0 +1,129 @@
+// compact_bench.cpp
+//
+// Cost and size of the compact encodings. Times packHalf and packInt16 per
+// value on a frame of 16, then whole messages as 32 bit floats and as a
+// blob of 16 bit words. It also works out the bytes per second a
+// connection carries, UDP and IP headers included, for accel and gyro and
+// the quaternion at 50Hz plus the 16-value EMG envelope at 200Hz, each sent
+// as its own datagram.
+// Build once as below, and again with -mf16c for the hardware half
+// conversion.
+//
+// built from this directory with the Myo SDK's include directory:
+//   g++ -std=gnu++11 -O2 -I.. -I../libs -I<Myo SDK>/include compact_bench.cpp ../MyoOscCompact.cpp
+//     ../osc/OscOutboundPacketStream.cpp ../osc/OscTypes.cpp
+
+#include "bench.h"
+
+#include "MyoOscCompact.h"
+#include "MyoOscSimd.h"
+#include "osc/OscOutboundPacketStream.h"
+
+#include <cstdio>
+
+#define ITERATIONS 10000000
+#define BUFFER_SIZE 256
+#define FRAME 16
+
+static char buffer[BUFFER_SIZE];
+
+static const char* halfPath() {
+#if defined(MYO_OSC_F16C)
+  return "F16C";
+#elif defined(MYO_OSC_NEON_FP16)
+  return "NEON";
+#else
+  return "scalar";
+#endif
+}
+
+struct Timing {
+  const char* name;
+  double nanos;
+  std::size_t size;
+};
+
+// times writing a message with write(stream, i), returning its cost and size
+template <typename Write>
+static Timing encode(const char* name, Write write) {
+  osc::OutboundPacketStream p(buffer, BUFFER_SIZE);
+  Timing result;
+  result.name = name;
+  result.nanos = nanosPer(ITERATIONS, [&](long i) {
+    p.Clear();
+    write(p, i);
+    keep(p.Size());
+  });
+  result.size = p.Size();
+  return result;
+}
+
+int main() {
+  float frame[FRAME];
+  for (int i = 0; i < FRAME; ++i)
+    frame[i] = i * 0.37f - 3;
+  Range range;
+  range.min = -4;
+  range.max = 4;
+  char packed[FRAME * 2];
+
+  double half = nanosPer(ITERATIONS, [&](long i) {
+    frame[0] = static_cast<float>(i & 0xff);
+    packHalf(frame, FRAME, packed);
+    keep(packed[1]);
+  });
+  double int16 = nanosPer(ITERATIONS, [&](long i) {
+    frame[0] = static_cast<float>(i & 0xff);
+    packInt16(frame, FRAME, range, packed);
+    keep(packed[1]);
+  });
+  std::printf("per value: half %.2f ns (%s), int16 %.2f ns\n", half / FRAME, halfPath(), int16 / FRAME);
+
+  float quat[4] = { 0.1f, 0.2f, 0.3f, 0.9f };
+  float accel[3] = { 0.1f, -0.9f, 0.2f };
+  Timing quatFloat = encode("quaternion", [&](osc::OutboundPacketStream& p, long i) {
+    quat[0] = static_cast<float>(i & 0xff);
+    p.WriteRepeatedMessage<4>("/myo/orientationQuat", quat);
+  });
+  Timing quatHalf = encode("", [&](osc::OutboundPacketStream& p, long i) {
+    quat[0] = static_cast<float>(i & 0xff);
+    packHalf(quat, 4, packed);
+    p.WriteMessage("/myo/orientationQuat", osc::Blob(packed, static_cast<osc::osc_bundle_element_size_t>(compactSize(4))));
+  });
+  Timing accelFloat = encode("accel", [&](osc::OutboundPacketStream& p, long i) {
+    accel[0] = static_cast<float>(i & 0xff);
+    p.WriteRepeatedMessage<3>("/myo/accel", accel);
+  });
+  Timing accelHalf = encode("", [&](osc::OutboundPacketStream& p, long i) {
+    accel[0] = static_cast<float>(i & 0xff);
+    packHalf(accel, 3, packed);
+    p.WriteMessage("/myo/accel", osc::Blob(packed, static_cast<osc::osc_bundle_element_size_t>(compactSize(3))));
+  });
+  Timing envelopeFloat = encode("envelope", [&](osc::OutboundPacketStream& p, long i) {
+    frame[0] = static_cast<float>(i & 0xff);
+    p.WriteRepeatedMessage<FRAME>("/myo/emg/envelope", frame);
+  });
+  Timing envelopeHalf = encode("", [&](osc::OutboundPacketStream& p, long i) {
+    frame[0] = static_cast<float>(i & 0xff);
+    packHalf(frame, FRAME, packed);
+    p.WriteMessage("/myo/emg/envelope", osc::Blob(packed, static_cast<osc::osc_bundle_element_size_t>(compactSize(FRAME))));
+  });
+
+  std::printf("%-12s %15s %15s\n", "message", "float", "half blob");
+  const Timing* rows[][2] = {
+    { &accelFloat, &accelHalf }, { &quatFloat, &quatHalf }, { &envelopeFloat, &envelopeHalf }
+  };
+  for (const auto& row : rows)
+    std::printf("%-12s %3u B %6.1f ns %3u B %6.1f ns\n", row[0]->name,
+                static_cast<unsigned>(row[0]->size), row[0]->nanos,
+                static_cast<unsigned>(row[1]->size), row[1]->nanos);
+
+  // gyro is the same shape as accel. int16 blobs are the same size as half ones.
+  const int overhead = 28;
+  double floatWire = 100.0 * (accelFloat.size + overhead) + 50.0 * (quatFloat.size + overhead) +
+    200.0 * (envelopeFloat.size + overhead);
+  double compactWire = 100.0 * (accelHalf.size + overhead) + 50.0 * (quatHalf.size + overhead) +
+    200.0 * (envelopeHalf.size + overhead);
+  std::printf("on the wire: %.0f B/s as floats, %.0f B/s compact\n", floatWire, compactWire);
+  return 0;
+}
@@ -0,0 +1,117 @@
+// emg_bands_bench.cpp
+//
+// Cost per hop of EmgBands against the window length, with the default
+// bands and a 16 sample hop, next to computing the same bins with a direct
+// DFT over the window at each hop. The sliding DFT's cost per hop follows
+// hop * bins; the direct one follows window * bins.
+//
+// built from this directory with the Myo SDK's include directory:
+//   g++ -std=gnu++11 -O2 -I.. -I../libs -I<Myo SDK>/include emg_bands_bench.cpp ../MyoOscEmg.cpp
+
+#include "bench.h"
+
+#include "MyoOscEmg.h"
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#define SAMPLE_ROWS 4096
+#define HOP 16
+#define HOPS 20000
+
+static int8_t samples[SAMPLE_ROWS][EMG_CHANNELS];
+
+// the same bins computed from scratch over the window at every hop
+class DirectBands {
+public:
+  DirectBands(int window, const std::vector<int>& bins)
+  : window_(window), pos_(0), bins_(bins), ring_(window * EMG_CHANNELS, 0.0f),
+    cos_(window), sin_(window), power_(bins.size() * EMG_CHANNELS) {
+    for (int i = 0; i < window; ++i) {
+      cos_[i] = static_cast<float>(std::cos(2 * M_PI * i / window));
+      sin_[i] = static_cast<float>(std::sin(2 * M_PI * i / window));
+    }
+  }
+
+  void push(const int8_t* emg) {
+    for (int c = 0; c < EMG_CHANNELS; ++c)
+      ring_[pos_ * EMG_CHANNELS + c] = emg[c];
+    if (++pos_ == window_)
+      pos_ = 0;
+  }
+
+  void transform() {
+    for (std::size_t b = 0; b < bins_.size(); ++b) {
+      float re[EMG_CHANNELS] = { 0 };
+      float im[EMG_CHANNELS] = { 0 };
+      int step = bins_[b];
+      int phase = 0;
+      for (int i = 0; i < window_; ++i) {
+        const float* row = &ring_[((pos_ + i) % window_) * EMG_CHANNELS];
+        for (int c = 0; c < EMG_CHANNELS; ++c) {
+          re[c] += row[c] * cos_[phase];
+          im[c] -= row[c] * sin_[phase];
+        }
+        phase += step;
+        if (phase >= window_)
+          phase -= window_;
+      }
+      for (int c = 0; c < EMG_CHANNELS; ++c)
+        power_[b * EMG_CHANNELS + c] = re[c] * re[c] + im[c] * im[c];
+    }
+  }
+
+  const float* power() const { return &power_[0]; }
+
+private:
+  int window_;
+  int pos_;
+  std::vector<int> bins_;
+  std::vector<float> ring_;
+  std::vector<float> cos_;
+  std::vector<float> sin_;
+  std::vector<float> power_;
+};
+
+int main() {
+  std::srand(1);
+  for (int i = 0; i < SAMPLE_ROWS; ++i)
+    for (int c = 0; c < EMG_CHANNELS; ++c)
+      samples[i][c] = static_cast<int8_t>(std::rand() % 256 - 128);
+
+  std::printf("%8s %6s %16s %16s\n", "window", "bins", "sliding ns/hop", "direct ns/hop");
+  const int windows[] = { 32, 64, 128, 256, 512 };
+  for (int window : windows) {
+    BandSettings settings;
+    settings.window = window;
+    settings.hop = HOP;
+    EmgBands bands;
+    bands.configure(settings);
+    double sliding = nanosPer(HOPS, [&](long hop) {
+      for (int i = 0; i < HOP; ++i)
+        bands.process(samples[(hop * HOP + i) % SAMPLE_ROWS]);
+      keep(bands.powers()[0]);
+    });
+
+    // the bins the default bands cover, as EmgBands picks them
+    std::vector<int> bins;
+    float low = settings.bands.front().low;
+    float high = settings.bands.back().high;
+    for (int k = 0; k <= window / 2; ++k) {
+      float freq = k * EMG_SAMPLE_RATE / window;
+      if (freq >= low && freq < high)
+        bins.push_back(k);
+    }
+    DirectBands direct(window, bins);
+    double recomputed = nanosPer(HOPS / 10, [&](long hop) {
+      for (int i = 0; i < HOP; ++i)
+        direct.push(samples[(hop * HOP + i) % SAMPLE_ROWS]);
+      direct.transform();
+      keep(direct.power()[0]);
+    });
+    std::printf("%8d %6u %16.0f %16.0f\n", window, static_cast<unsigned>(bins.size()), sliding, recomputed);
+  }
+  return 0;
+}
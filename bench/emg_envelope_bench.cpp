@@ -0,0 +1,80 @@
+// emg_envelope_bench.cpp
+//
+// Cost per EMG sample (all 8 channels) of EmgEnvelope against the window
+// length, next to a moving RMS that re-sums the whole window each sample.
+// The running sum should stay flat as the window grows; the re-sum grows
+// with it.
+//
+// built from this directory with the Myo SDK's include directory:
+//   g++ -std=gnu++11 -O2 -I.. -I../libs -I<Myo SDK>/include emg_envelope_bench.cpp ../MyoOscEmg.cpp
+
+#include "bench.h"
+
+#include "MyoOscEmg.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// rows of synthetic EMG, cycled through so generating it isn't timed
+#define SAMPLE_ROWS 4096
+#define ITERATIONS 1000000
+
+static int8_t samples[SAMPLE_ROWS][EMG_CHANNELS];
+
+// the straightforward moving RMS, for comparison
+class ResummedRms {
+public:
+  explicit ResummedRms(int window) : window_(window), pos_(0), ring_(window * EMG_CHANNELS, 0) { }
+
+  void process(const int8_t* emg) {
+    for (int c = 0; c < EMG_CHANNELS; ++c)
+      ring_[pos_ * EMG_CHANNELS + c] = emg[c];
+    if (++pos_ == window_)
+      pos_ = 0;
+    for (int c = 0; c < EMG_CHANNELS; ++c) {
+      int32_t sum = 0;
+      for (int i = 0; i < window_; ++i) {
+        int32_t x = ring_[i * EMG_CHANNELS + c];
+        sum += x * x;
+      }
+      rms_[c] = std::sqrt(sum / static_cast<float>(window_));
+    }
+  }
+
+  const float* rms() const { return rms_; }
+
+private:
+  int window_;
+  int pos_;
+  std::vector<int8_t> ring_;
+  float rms_[EMG_CHANNELS];
+};
+
+int main() {
+  std::srand(1);
+  for (int i = 0; i < SAMPLE_ROWS; ++i)
+    for (int c = 0; c < EMG_CHANNELS; ++c)
+      samples[i][c] = static_cast<int8_t>(std::rand() % 256 - 128);
+
+  std::printf("%8s %14s %14s\n", "window", "envelope ns", "re-sum ns");
+  const int windows[] = { 8, 40, 200, 1000, 4000 };
+  for (int window : windows) {
+    EnvelopeSettings settings;
+    settings.window = window;
+    EmgEnvelope envelope;
+    envelope.configure(settings);
+    double streaming = nanosPer(ITERATIONS, [&](long i) {
+      envelope.process(samples[i % SAMPLE_ROWS]);
+      keep(envelope.rms()[0]);
+    });
+    ResummedRms resummed(window);
+    // fewer iterations, it is slow at the long windows
+    double resumming = nanosPer(ITERATIONS / 100, [&](long i) {
+      resummed.process(samples[i % SAMPLE_ROWS]);
+      keep(resummed.rms()[0]);
+    });
+    std::printf("%8d %14.1f %14.1f\n", window, streaming, resumming);
+  }
+  return 0;
+}
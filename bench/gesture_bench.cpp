@@ -0,0 +1,67 @@
+// gesture_bench.cpp
+//
+// Cost of GestureEngine per EMG sample, with an accel and gyro sample every
+// fourth EMG sample as the armband sends them, for both classifiers and a
+// range of class counts. The models are made up; only their size matters.
+//
+// built from this directory with the Myo SDK's include directory:
+//   g++ -std=gnu++11 -O2 -I.. -I../libs -I<Myo SDK>/include gesture_bench.cpp ../MyoOscGesture.cpp
+
+#include "bench.h"
+
+#include "MyoOscGesture.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#define SAMPLE_ROWS 4096
+#define ITERATIONS 1000000
+
+static int8_t samples[SAMPLE_ROWS][GESTURE_EMG_CHANNELS];
+
+static GestureModel makeModel(GestureClassifier classifier, int classes) {
+  GestureModel model;
+  model.classifier = classifier;
+  model.version = 1;
+  for (int i = 0; i < classes; ++i) {
+    GestureClass gesture;
+    gesture.name = i == 0 ? "rest" : "class" + std::to_string(i);
+    for (int f = 0; f < GESTURE_FEATURES; ++f)
+      gesture.values[f] = static_cast<float>(std::rand() % 200 - 100) / 10;
+    gesture.bias = 0;
+    gesture.rest = i == 0;
+    model.classes.push_back(gesture);
+  }
+  return model;
+}
+
+int main() {
+  std::srand(1);
+  for (int i = 0; i < SAMPLE_ROWS; ++i)
+    for (int c = 0; c < GESTURE_EMG_CHANNELS; ++c)
+      samples[i][c] = static_cast<int8_t>(std::rand() % 256 - 128);
+
+  std::printf("%8s %10s %12s\n", "classes", "classifier", "ns/sample");
+  const int counts[] = { 2, 8, 32 };
+  const GestureClassifier classifiers[] = { GestureClassifier::CENTROID, GestureClassifier::LINEAR };
+  for (int classes : counts) {
+    for (GestureClassifier classifier : classifiers) {
+      GestureSettings settings;
+      settings.model = makeModel(classifier, classes);
+      GestureEngine engine;
+      engine.configure(settings);
+      myo::Vector3<float> accel(0, 0, 1);
+      myo::Vector3<float> gyro(1, 2, 3);
+      double nanos = nanosPer(ITERATIONS, [&](long i) {
+        if (i % 4 == 0) {
+          engine.addAccel(accel);
+          engine.addGyro(gyro);
+        }
+        keep(engine.addEmg(samples[i % SAMPLE_ROWS]));
+      });
+      std::printf("%8d %10s %12.1f\n", classes,
+                  classifier == GestureClassifier::CENTROID ? "centroid" : "linear", nanos);
+    }
+  }
+  return 0;
+}
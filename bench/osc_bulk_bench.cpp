@@ -0,0 +1,92 @@
+// osc_bulk_bench.cpp
+//
+// Throughput of moving a long run of floats into and out of a message,
+// one stream operator per value against WriteFloats and ReadFloats, which
+// convert the byte order in bulk. Which bulk path is used depends on the
+// target: build once as below for SSE2 on x86-64, and again with -mssse3
+// for pshufb.
+//
+// built from this directory:
+//   g++ -std=gnu++11 -O2 -I.. osc_bulk_bench.cpp ../osc/OscOutboundPacketStream.cpp
+//     ../osc/OscReceivedElements.cpp ../osc/OscTypes.cpp
+
+#include "bench.h"
+
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscReceivedElements.h"
+
+#include <cstdio>
+#include <cstring>
+
+#define VALUES 16384
+#define ITERATIONS 2000
+// values, their type tags and some room for the address
+#define BUFFER_SIZE (VALUES * 5 + 256)
+
+static char streamed[BUFFER_SIZE];
+static char written[BUFFER_SIZE];
+static float values[VALUES];
+static float decoded[VALUES];
+
+static const char* bulkPath() {
+#if defined(OSC_BYTE_ORDER_SSSE3)
+  return "SSSE3";
+#elif defined(OSC_BYTE_ORDER_SSE2)
+  return "SSE2";
+#elif defined(OSC_BYTE_ORDER_NEON)
+  return "NEON";
+#else
+  return "scalar";
+#endif
+}
+
+// megabytes of float data per second
+static double megabytesPerSecond(double nanos) {
+  return VALUES * sizeof(float) / nanos * 1e3;
+}
+
+int main() {
+  for (int i = 0; i < VALUES; ++i)
+    values[i] = i * 0.25f - 100;
+
+  double streamEncode = nanosPer(ITERATIONS, [](long) {
+    osc::OutboundPacketStream p(streamed, BUFFER_SIZE);
+    p << osc::BeginMessage("/myo/emg/bands");
+    for (int i = 0; i < VALUES; ++i)
+      p << values[i];
+    p << osc::EndMessage;
+    keep(p.Size());
+  });
+  std::size_t size = 0;
+  double bulkEncode = nanosPer(ITERATIONS, [&size](long) {
+    osc::OutboundPacketStream p(written, BUFFER_SIZE);
+    p << osc::BeginMessage("/myo/emg/bands");
+    p.WriteFloats(values, VALUES);
+    p << osc::EndMessage;
+    size = p.Size();
+    keep(size);
+  });
+  if (std::memcmp(streamed, written, size) != 0)
+    std::printf("OUTPUT DIFFERS\n");
+
+  osc::ReceivedMessage message(osc::ReceivedPacket(written, size));
+  double streamDecode = nanosPer(ITERATIONS, [&message](long) {
+    osc::ReceivedMessageArgumentStream args = message.ArgumentStream();
+    for (int i = 0; i < VALUES; ++i)
+      args >> decoded[i];
+    keep(decoded[VALUES - 1]);
+  });
+  double bulkDecode = nanosPer(ITERATIONS, [&message](long) {
+    osc::ReceivedMessageArgumentStream args = message.ArgumentStream();
+    args.ReadFloats(decoded, VALUES);
+    keep(decoded[VALUES - 1]);
+  });
+  if (std::memcmp(values, decoded, sizeof(values)) != 0)
+    std::printf("DECODED VALUES DIFFER\n");
+
+  std::printf("%d floats per message, bulk path %s\n", VALUES, bulkPath());
+  std::printf("%-8s %14s %14s\n", "", "stream MB/s", "bulk MB/s");
+  std::printf("%-8s %14.0f %14.0f\n", "encode", megabytesPerSecond(streamEncode), megabytesPerSecond(bulkEncode));
+  std::printf("%-8s %14.0f %14.0f\n", "decode", megabytesPerSecond(streamDecode), megabytesPerSecond(bulkDecode));
+  return 0;
+}
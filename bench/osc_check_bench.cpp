@@ -0,0 +1,127 @@
+// osc_check_bench.cpp
+//
+// Throughput of ReceivedPacket::Check on its own over a corpus of valid
+// and malformed packets. The corpus is built the way the fuzz target is
+// usually seeded: a bundle with a nested bundle and most argument types,
+// a calibrate message and bundles nested to the depth limit, each copied
+// many times with a few random bytes changed, dropped or inserted. The
+// random numbers are seeded, so every run checks the same packets.
+//
+// built from this directory:
+//   g++ -std=gnu++11 -O2 -I.. osc_check_bench.cpp ../osc/OscOutboundPacketStream.cpp
+//     ../osc/OscReceivedElements.cpp ../osc/OscTypes.cpp
+
+#include "bench.h"
+
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscReceivedElements.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#define CORPUS_SIZE 4000
+#define PASSES 200
+#define BUFFER_SIZE 1024
+
+typedef std::vector<char> Packet;
+
+static Packet seal(const osc::OutboundPacketStream& p) {
+  return Packet(p.Data(), p.Data() + p.Size());
+}
+
+static std::vector<Packet> seeds() {
+  std::vector<Packet> result;
+  char buffer[BUFFER_SIZE];
+
+  osc::OutboundPacketStream nested(buffer, BUFFER_SIZE);
+  nested << osc::BeginBundleImmediate
+    << osc::BeginMessage("/m") << 1.0f << "str" << osc::Blob("abcde", 5) << osc::EndMessage
+    << osc::BeginBundleImmediate
+    << osc::BeginMessage("/n") << static_cast<osc::int32>(3) << osc::EndMessage
+    << osc::EndBundle
+    << osc::BeginMessage("/o") << osc::EndMessage
+    << osc::BeginMessage("/p") << osc::BeginArray << 1.5f << osc::EndArray << true
+    << osc::Symbol("s") << static_cast<osc::int64>(5) << 2.0 << osc::EndMessage
+    << osc::EndBundle;
+  result.push_back(seal(nested));
+
+  osc::OutboundPacketStream calibrate(buffer, BUFFER_SIZE);
+  calibrate << osc::BeginMessage("/myo-osc/calibrate") << 1.0f << 2.0f << 3.0f << 4.0f
+    << osc::EndMessage;
+  result.push_back(seal(calibrate));
+
+  osc::OutboundPacketStream deep(buffer, BUFFER_SIZE);
+  for (int i = 0; i < osc::ReceivedPacket::MAX_BUNDLE_DEPTH; ++i)
+    deep << osc::BeginBundleImmediate;
+  deep << osc::BeginMessage("/x") << osc::EndMessage;
+  for (int i = 0; i < osc::ReceivedPacket::MAX_BUNDLE_DEPTH; ++i)
+    deep << osc::EndBundle;
+  result.push_back(seal(deep));
+
+  return result;
+}
+
+// up to three edits: a random byte, a zero byte, a truncation or an insertion
+static void mutate(Packet& packet, std::mt19937& random) {
+  int edits = random() % 4;
+  for (int i = 0; i < edits; ++i) {
+    std::size_t at = random() % packet.size();
+    switch (random() % 4) {
+      case 0: packet[at] = static_cast<char>(random()); break;
+      case 1: packet[at] = 0; break;
+      case 2: if (packet.size() > 4) packet.resize(packet.size() - 1 - random() % 4); break;
+      default: packet.insert(packet.begin() + at, static_cast<char>(random() % 3 ? random() : 0)); break;
+    }
+  }
+}
+
+struct Throughput {
+  double nanosPerPacket;
+  double megabytesPerSecond;
+};
+
+static Throughput check(const std::vector<Packet>& corpus) {
+  std::size_t bytes = 0;
+  for (const Packet& packet : corpus)
+    bytes += packet.size();
+  double nanos = nanosPer(PASSES, [&](long) {
+    for (const Packet& packet : corpus)
+      keep(osc::ReceivedPacket::Check(packet.data(), packet.size()));
+  });
+  Throughput t;
+  t.nanosPerPacket = nanos / corpus.size();
+  t.megabytesPerSecond = bytes / nanos * 1e3;
+  return t;
+}
+
+int main() {
+  std::vector<Packet> base = seeds();
+  std::mt19937 random(11);
+  std::vector<Packet> valid, malformed;
+  for (int i = 0; i < CORPUS_SIZE; ++i) {
+    Packet packet = base[i % base.size()];
+    mutate(packet, random);
+    if (osc::ReceivedPacket::Check(packet.data(), packet.size()))
+      malformed.push_back(packet);
+    else
+      valid.push_back(packet);
+  }
+  std::vector<Packet> mixed;
+  for (std::size_t i = 0; i < valid.size() || i < malformed.size(); ++i) {
+    if (i < valid.size())
+      mixed.push_back(valid[i]);
+    if (i < malformed.size())
+      mixed.push_back(malformed[i]);
+  }
+
+  std::printf("%-10s %8s %12s %8s\n", "corpus", "packets", "ns/packet", "MB/s");
+  const std::vector<Packet>* corpora[] = { &valid, &malformed, &mixed };
+  const char* names[] = { "valid", "malformed", "mixed" };
+  for (int i = 0; i < 3; ++i) {
+    Throughput t = check(*corpora[i]);
+    std::printf("%-10s %8zu %12.1f %8.0f\n", names[i], corpora[i]->size(),
+                t.nanosPerPacket, t.megabytesPerSecond);
+  }
+  return 0;
+}
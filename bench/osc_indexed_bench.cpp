@@ -0,0 +1,81 @@
+// osc_indexed_bench.cpp
+//
+// Cost of decoding received messages with ReceivedMessageArgumentStream
+// and with IndexedReceivedMessage. The control receiver's 4-float
+// calibrate message is read in order from the packet, so both pay for the
+// message validation; then the arguments of a 16-float message are read in
+// reverse, where an iterator has to step past the ones in front each time.
+//
+// built from this directory:
+//   g++ -std=gnu++11 -O2 -I.. osc_indexed_bench.cpp ../osc/OscOutboundPacketStream.cpp
+//     ../osc/OscReceivedElements.cpp ../osc/OscTypes.cpp
+
+#include "bench.h"
+
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscReceivedElements.h"
+
+#include <cstdio>
+
+#define ITERATIONS 5000000
+#define BUFFER_SIZE 256
+#define LONG_MESSAGE 16
+
+int main() {
+  char calibrate[BUFFER_SIZE];
+  osc::OutboundPacketStream p(calibrate, BUFFER_SIZE);
+  p << osc::BeginMessage("/myo-osc/calibrate") << 0.1f << 0.2f << 0.3f << 0.9f << osc::EndMessage;
+  std::size_t calibrateSize = p.Size();
+
+  double validate = nanosPer(ITERATIONS, [&](long) {
+    osc::ReceivedMessage message(osc::ReceivedPacket(calibrate, calibrateSize));
+    keep(message.ArgumentCount());
+  });
+  double streamed = nanosPer(ITERATIONS, [&](long) {
+    osc::ReceivedMessage message(osc::ReceivedPacket(calibrate, calibrateSize));
+    float x, y, z, w;
+    message.ArgumentStream() >> x >> y >> z >> w >> osc::EndMessage;
+    keep(x + y + z + w);
+  });
+  double indexed = nanosPer(ITERATIONS, [&](long) {
+    osc::ReceivedMessage message(osc::ReceivedPacket(calibrate, calibrateSize));
+    osc::IndexedReceivedMessage arguments(message);
+    if (arguments.Matches(",ffff"))
+      keep(arguments.AsFloatUnchecked(0) + arguments.AsFloatUnchecked(1) +
+           arguments.AsFloatUnchecked(2) + arguments.AsFloatUnchecked(3));
+  });
+  std::printf("4-float message from the packet\n");
+  std::printf("  validation only %6.1f ns\n", validate);
+  std::printf("  stream          %6.1f ns\n", streamed);
+  std::printf("  indexed         %6.1f ns\n", indexed);
+
+  char frame[BUFFER_SIZE];
+  osc::OutboundPacketStream q(frame, BUFFER_SIZE);
+  q << osc::BeginMessage("/myo/emg/envelope");
+  for (int i = 0; i < LONG_MESSAGE; ++i)
+    q << static_cast<float>(i);
+  q << osc::EndMessage;
+  osc::ReceivedMessage message(osc::ReceivedPacket(frame, q.Size()));
+
+  double reverseStreamed = nanosPer(ITERATIONS / 10, [&](long) {
+    float sum = 0;
+    for (int i = LONG_MESSAGE - 1; i >= 0; --i) {
+      osc::ReceivedMessage::const_iterator arg = message.ArgumentsBegin();
+      for (int skip = 0; skip < i; ++skip)
+        ++arg;
+      sum += arg->AsFloat();
+    }
+    keep(sum);
+  });
+  double reverseIndexed = nanosPer(ITERATIONS / 10, [&](long) {
+    osc::IndexedReceivedMessage arguments(message);
+    float sum = 0;
+    for (int i = LONG_MESSAGE - 1; i >= 0; --i)
+      sum += arguments.AsFloatUnchecked(i);
+    keep(sum);
+  });
+  std::printf("%d-float message read in reverse, already validated\n", LONG_MESSAGE);
+  std::printf("  iterator        %6.1f ns\n", reverseStreamed);
+  std::printf("  indexed         %6.1f ns\n", reverseIndexed);
+  return 0;
+}
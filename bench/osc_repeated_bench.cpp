@@ -0,0 +1,68 @@
+// osc_repeated_bench.cpp
+//
+// Cost of encoding the generator's EMG messages, 8 ints for raw EMG and 8
+// or 16 floats for the filtered EMG and the envelope, with a stream
+// operator per value and with OutboundPacketStream::WriteRepeatedMessage.
+// Both should produce the same bytes.
+//
+// built from this directory:
+//   g++ -std=gnu++11 -O2 -I.. osc_repeated_bench.cpp ../osc/OscOutboundPacketStream.cpp ../osc/OscTypes.cpp
+
+#include "bench.h"
+
+#include "osc/OscOutboundPacketStream.h"
+
+#include <cstdio>
+#include <cstring>
+
+#define ITERATIONS 2000000
+#define BUFFER_SIZE 1024
+
+static char streamed[BUFFER_SIZE];
+static char written[BUFFER_SIZE];
+
+template <std::size_t N, typename T>
+static void streamValues(osc::OutboundPacketStream& p, const char* address, const T* values) {
+  p << osc::BeginMessage(address);
+  for (std::size_t i = 0; i < N; ++i)
+    p << values[i];
+  p << osc::EndMessage;
+}
+
+template <std::size_t N, typename T>
+static void compare(const char* name, const char* address, T* values) {
+  osc::OutboundPacketStream a(streamed, BUFFER_SIZE);
+  osc::OutboundPacketStream b(written, BUFFER_SIZE);
+  streamValues<N>(a, address, values);
+  b.WriteRepeatedMessage<N>(address, values);
+  bool same = a.Size() == b.Size() && std::memcmp(a.Data(), b.Data(), a.Size()) == 0;
+
+  double streamNanos = nanosPer(ITERATIONS, [&](long i) {
+    values[0] = static_cast<T>(i);
+    osc::OutboundPacketStream p(streamed, BUFFER_SIZE);
+    streamValues<N>(p, address, values);
+    keep(p.Size());
+  });
+  double writeNanos = nanosPer(ITERATIONS, [&](long i) {
+    values[0] = static_cast<T>(i);
+    osc::OutboundPacketStream p(written, BUFFER_SIZE);
+    p.WriteRepeatedMessage<N>(address, values);
+    keep(p.Size());
+  });
+  std::printf("%-14s %4u bytes %10.1f %12.1f %s\n", name, static_cast<unsigned>(b.Size()),
+              streamNanos, writeNanos, same ? "" : "OUTPUT DIFFERS");
+}
+
+int main() {
+  osc::int32 emg[8] = { -3, 12, 0, 127, -128, 5, 7, -9 };
+  float filtered[8] = { -0.5f, 1.25f, 3, 4, 5, 6, 7, 8 };
+  float envelope[16];
+  for (int i = 0; i < 16; ++i)
+    envelope[i] = i * 0.75f;
+
+  std::printf("%-14s %10s %10s %12s\n", "message", "", "stream ns", "repeated ns");
+  compare<8>("emg, 8 ints", "/myo/emg", emg);
+  compare<8>("filtered, 8", "/myo/emg/filtered", filtered);
+  compare<16>("envelope, 16", "/myo/emg/envelope", envelope);
+  return 0;
+}
@@ -0,0 +1,119 @@
+// osc_validation_bench.cpp
+//
+// Cost of receiving a 2-message bundle, valid and malformed, and a bundle
+// of two myo-osc sized messages, the way
+// OscPacketListener used to (parse with the throwing constructors, catch
+// the exception) and the way it does now (ReceivedPacket::Check, then one
+// parse that can't fail). Also the cost of encoding a message with the
+// throwing OutboundPacketStream against the sticky error one.
+//
+// built from this directory:
+//   g++ -std=gnu++11 -O2 -I.. osc_validation_bench.cpp ../osc/OscOutboundPacketStream.cpp
+//     ../osc/OscReceivedElements.cpp ../osc/OscTypes.cpp
+//     ../ip/IpEndpointName.cpp ../ip/posix/NetworkingUtils.cpp
+
+#include "bench.h"
+
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscPacketListener.h"
+#include "ip/IpEndpointName.h"
+
+#include <cstdio>
+#include <cstring>
+
+#define ITERATIONS 2000000
+#define BUFFER_SIZE 256
+
+class CountingListener : public osc::OscPacketListener {
+public:
+  CountingListener() : messages(0), malformed(0) { }
+
+  // OscPacketListener::ProcessPacket as it was before the check-first path
+  void processThrowing(const char* data, int size, const IpEndpointName& remoteEndpoint) {
+    try {
+      osc::ReceivedPacket packet(data, size);
+      if (packet.IsBundle())
+        ProcessBundle(osc::ReceivedBundle(packet), remoteEndpoint);
+      else
+        ProcessMessage(osc::ReceivedMessage(packet), remoteEndpoint);
+    } catch (const osc::Exception&) {
+      ++malformed;
+    }
+  }
+
+  long messages;
+  long malformed;
+
+protected:
+  void ProcessMessage(const osc::ReceivedMessage& m, const IpEndpointName& remoteEndpoint) {
+    (void)remoteEndpoint;
+    messages += m.ArgumentCount();
+  }
+
+  void ProcessMalformedPacket(const char* error, const IpEndpointName& remoteEndpoint) {
+    (void)error;
+    (void)remoteEndpoint;
+    ++malformed;
+  }
+};
+
+int main() {
+  char valid[BUFFER_SIZE];
+  osc::OutboundPacketStream p(valid, BUFFER_SIZE);
+  p << osc::BeginBundleImmediate
+    << osc::BeginMessage("/m") << 1.0f << "str" << osc::EndMessage
+    << osc::BeginMessage("/n") << static_cast<osc::int32>(3) << osc::EndMessage
+    << osc::EndBundle;
+  int size = static_cast<int>(p.Size());
+  // a non-zero pad byte after the second message's type tags
+  char malformed[BUFFER_SIZE];
+  std::memcpy(malformed, valid, size);
+  malformed[size - 5] = 'x';
+
+  // the same shape with addresses and arguments like the generator's
+  char myo[BUFFER_SIZE];
+  osc::OutboundPacketStream q(myo, BUFFER_SIZE);
+  const float values[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+  q << osc::BeginBundleImmediate;
+  q.WriteRepeatedMessage<4>("/myo/orientation/quaternion", values);
+  q.WriteRepeatedMessage<8>("/myo/emg/envelope/channels", values);
+  q << osc::EndBundle;
+  int sizes[] = { size, size, static_cast<int>(q.Size()) };
+
+  IpEndpointName from;
+  CountingListener listener;
+  std::printf("%-10s %12s %14s\n", "bundle", "throwing ns", "check-first ns");
+  const char* packets[] = { valid, malformed, myo };
+  const char* names[] = { "valid", "malformed", "myo" };
+  for (int i = 0; i < 3; ++i) {
+    const char* data = packets[i];
+    int dataSize = sizes[i];
+    double throwing = nanosPer(ITERATIONS / (i == 1 ? 20 : 1), [&](long) {
+      listener.processThrowing(data, dataSize, from);
+    });
+    double checked = nanosPer(ITERATIONS, [&](long) {
+      listener.ProcessPacket(data, dataSize, from);
+    });
+    std::printf("%-10s %12.1f %14.1f\n", names[i], throwing, checked);
+  }
+  keep(listener.messages);
+
+  char out[BUFFER_SIZE];
+  osc::OutboundPacketStream throwingStream(out, BUFFER_SIZE);
+  osc::OutboundPacketStream stickyStream(out, BUFFER_SIZE);
+  stickyStream.SetThrowOnError(false);
+  const float quaternion[4] = { 1, 2, 3, 4 };
+  double throwingEncode = nanosPer(ITERATIONS * 5, [&](long) {
+    throwingStream.Clear();
+    throwingStream.WriteRepeatedMessage<4>("/myo/orientation", quaternion);
+    keep(throwingStream.Size());
+  });
+  double stickyEncode = nanosPer(ITERATIONS * 5, [&](long) {
+    stickyStream.Clear();
+    stickyStream.WriteRepeatedMessage<4>("/myo/orientation", quaternion);
+    if (stickyStream.IsOk())
+      keep(stickyStream.Size());
+  });
+  std::printf("encode: throwing %.1f ns, sticky %.1f ns\n", throwingEncode, stickyEncode);
+  return 0;
+}
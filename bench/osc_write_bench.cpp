@@ -0,0 +1,76 @@
+// osc_write_bench.cpp
+//
+// Cost of encoding the generator's fixed-shape messages with the stream
+// operators (BeginMessage << ... << EndMessage) and with the single-pass
+// OutboundPacketStream::WriteMessage, which should produce the same bytes.
+//
+// built from this directory:
+//   g++ -std=gnu++11 -O2 -I.. osc_write_bench.cpp ../osc/OscOutboundPacketStream.cpp ../osc/OscTypes.cpp
+
+#include "bench.h"
+
+#include "osc/OscOutboundPacketStream.h"
+
+#include <cstdio>
+#include <cstring>
+
+#define ITERATIONS 2000000
+#define BUFFER_SIZE 1024
+
+static char streamed[BUFFER_SIZE];
+static char written[BUFFER_SIZE];
+
+template <typename Stream, typename Write>
+static void compare(const char* name, Stream stream, Write write) {
+  osc::OutboundPacketStream a(streamed, BUFFER_SIZE);
+  osc::OutboundPacketStream b(written, BUFFER_SIZE);
+  stream(a, 0);
+  write(b, 0);
+  bool same = a.Size() == b.Size() && std::memcmp(a.Data(), b.Data(), a.Size()) == 0;
+
+  double streamNanos = nanosPer(ITERATIONS, [&](long i) {
+    osc::OutboundPacketStream p(streamed, BUFFER_SIZE);
+    stream(p, static_cast<float>(i));
+    keep(p.Size());
+  });
+  double writeNanos = nanosPer(ITERATIONS, [&](long i) {
+    osc::OutboundPacketStream p(written, BUFFER_SIZE);
+    write(p, static_cast<float>(i));
+    keep(p.Size());
+  });
+  std::printf("%-12s %4u bytes %10.1f %14.1f %s\n", name, static_cast<unsigned>(b.Size()),
+              streamNanos, writeNanos, same ? "" : "OUTPUT DIFFERS");
+}
+
+int main() {
+  std::printf("%-12s %10s %10s %14s\n", "message", "", "stream ns", "WriteMessage ns");
+  compare("scalar",
+    [](osc::OutboundPacketStream& p, float x) {
+      p << osc::BeginMessage("/myo/pose/confidence") << x << osc::EndMessage;
+    },
+    [](osc::OutboundPacketStream& p, float x) {
+      p.WriteMessage("/myo/pose/confidence", x);
+    });
+  compare("vector",
+    [](osc::OutboundPacketStream& p, float x) {
+      p << osc::BeginMessage("/myo/accel") << x << 2.0f << 3.0f << osc::EndMessage;
+    },
+    [](osc::OutboundPacketStream& p, float x) {
+      p.WriteMessage("/myo/accel", x, 2.0f, 3.0f);
+    });
+  compare("quaternion",
+    [](osc::OutboundPacketStream& p, float x) {
+      p << osc::BeginMessage("/myo/orientation") << x << 2.0f << 3.0f << 4.0f << osc::EndMessage;
+    },
+    [](osc::OutboundPacketStream& p, float x) {
+      p.WriteMessage("/myo/orientation", x, 2.0f, 3.0f, 4.0f);
+    });
+  compare("gesture",
+    [](osc::OutboundPacketStream& p, float x) {
+      p << osc::BeginMessage("/myo/gesture") << "fist" << x << osc::EndMessage;
+    },
+    [](osc::OutboundPacketStream& p, float x) {
+      p.WriteMessage("/myo/gesture", "fist", x);
+    });
+  return 0;
+}
@@ -0,0 +1,90 @@
+// pacing_bench.cpp
+//
+// Inter-arrival jitter at a local receiver for a 200Hz stream delivered the
+// way libmyo hands it over: four events 5ms apart, all at once every 20ms.
+// Sent straight away the gaps alternate between ~0 and ~15ms; through the
+// Pacer they should come out close to 5ms each, more so with a longer spin.
+//
+// built from this directory with the Myo SDK's include directory:
+//   g++ -std=gnu++11 -O2 -pthread -I.. -I../libs -I<Myo SDK>/include pacing_bench.cpp
+//     ../MyoOscPacer.cpp ../MyoOscSender.cpp ../MyoOscStats.cpp ../MyoOscSettings.cpp
+//     ../MyoOscFilter.cpp ../MyoOscGesture.cpp ../osc/OscOutboundPacketStream.cpp ../osc/OscTypes.cpp
+//     ../ip/IpEndpointName.cpp ../ip/posix/NetworkingUtils.cpp ../ip/posix/UdpSocket.cpp
+// takes the number of 20ms clumps per run (default 500).
+
+#include "bench.h"
+
+#include "MyoOscPacer.h"
+#include "MyoOscSender.h"
+#include "ip/UdpSocket.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#define BENCH_PORT 47121
+#define EVENTS_PER_CLUMP 4
+#define EVENT_INTERVAL 5000
+#define CLUMP_INTERVAL (EVENTS_PER_CLUMP * EVENT_INTERVAL)
+
+// the pacer schedules against the wall clock, like the time tags it's fed
+static int64_t wallMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// pacing disabled sends each packet as soon as its clump arrives
+static void runOnce(const char* name, const PacingSettings& pacing, int clumps) {
+  UdpReceiveSocket socket(IpEndpointName("127.0.0.1", BENCH_PORT));
+  const int packets = clumps * EVENTS_PER_CLUMP;
+  std::vector<int64_t> arrivals;
+  arrivals.reserve(packets);
+  std::thread receiver([&] {
+    char data[256];
+    IpEndpointName from;
+    while (static_cast<int>(arrivals.size()) < packets) {
+      socket.ReceiveFrom(from, data, sizeof(data));
+      arrivals.push_back(nowMicros());
+    }
+  });
+
+  OscSender sender("127.0.0.1", BENCH_PORT, SendSettings());
+  Pacer pacer(&sender, pacing);
+  if (pacing.enabled)
+    pacer.start();
+  char packet[8] = "/x";
+  int64_t start = wallMicros();
+  for (int clump = 0; clump < clumps; ++clump) {
+    // the clump arrives when its last event has been sampled
+    int64_t first = start + static_cast<int64_t>(clump) * CLUMP_INTERVAL;
+    std::this_thread::sleep_for(std::chrono::microseconds(first + CLUMP_INTERVAL - EVENT_INTERVAL - wallMicros()));
+    for (int k = 0; k < EVENTS_PER_CLUMP; ++k) {
+      int64_t sampled = first + k * EVENT_INTERVAL;
+      if (pacing.enabled)
+        pacer.schedule(sampled + static_cast<int64_t>(pacing.delay * 1000), packet, sizeof(packet),
+                       OutputId::EMG, Priority::STREAM);
+      else
+        sender.send(packet, sizeof(packet), OutputId::EMG, Priority::STREAM);
+    }
+  }
+  receiver.join();
+  if (pacing.enabled)
+    pacer.stop();
+
+  Jitter jitter(arrivals);
+  std::printf("%-16s gap %7.1f us, deviation stddev %7.1f us, p99 %7.1f us, max %7.1f us, late %llu\n",
+              name, jitter.mean, jitter.stddev, jitter.p99, jitter.max,
+              static_cast<unsigned long long>(pacer.late()));
+}
+
+int main(int argc, char** argv) {
+  int clumps = argc > 1 ? std::atoi(argv[1]) : 500;
+
+  PacingSettings pacing;
+  runOnce("direct", pacing, clumps);
+  pacing.enabled = true;
+  runOnce("paced", pacing, clumps);
+  pacing.spin = 2000;
+  runOnce("paced, 2ms spin", pacing, clumps);
+  return 0;
+}
@@ -0,0 +1,118 @@
+// realtime_bench.cpp
+//
+// Inter-arrival jitter of a 200Hz packet stream under CPU contention, with
+// the sending thread on ordinary scheduling and then with the realtime
+// options (SCHED_FIFO, pinned to a core, memory locked, stack prefaulted).
+// A local receiver, given the realtime treatment in both runs where
+// possible, timestamps each arrival while busy threads load every core.
+// FIFO needs root or CAP_SYS_NICE; without it the warnings say so and both
+// runs use ordinary scheduling.
+//
+// built from this directory with the Myo SDK's include directory:
+//   g++ -std=gnu++11 -O2 -pthread -I.. -I../libs -I<Myo SDK>/include realtime_bench.cpp
+//     ../MyoOscRealtime.cpp ../MyoOscSettings.cpp ../MyoOscFilter.cpp ../MyoOscGesture.cpp
+//     ../osc/OscOutboundPacketStream.cpp ../osc/OscTypes.cpp
+//     ../ip/IpEndpointName.cpp ../ip/posix/NetworkingUtils.cpp ../ip/posix/UdpSocket.cpp
+// takes the seconds per run (default 10) and the number of busy threads
+// (default two per core).
+
+#include "bench.h"
+
+#include "MyoOscRealtime.h"
+#include "ip/UdpSocket.h"
+#include "osc/OscOutboundPacketStream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#define BENCH_PORT 47120
+// 200Hz, the EMG rate
+#define SEND_INTERVAL 5000
+
+static std::vector<int64_t> runOnce(const RealtimeSettings& sender, const RealtimeSettings& receiver,
+                                    int seconds, int busyThreads) {
+  std::atomic<bool> done(false);
+  std::vector<std::thread> busy;
+  for (int i = 0; i < busyThreads; ++i) {
+    busy.emplace_back([&done] {
+      // enough memory traffic to compete for cache as well as cores
+      std::vector<float> work(1 << 16, 1.0f);
+      float sum = 0;
+      while (!done) {
+        for (float& x : work)
+          sum += x *= 1.0001f;
+        keep(sum);
+      }
+    });
+  }
+
+  const int packets = seconds * (1000000 / SEND_INTERVAL);
+  std::vector<int64_t> arrivals;
+  arrivals.reserve(packets);
+  UdpReceiveSocket socket(IpEndpointName("127.0.0.1", BENCH_PORT));
+  std::thread receiverThread([&] {
+    applyThreadRealtime(receiver, receiver.hubCpu, "receiver");
+    char data[256];
+    IpEndpointName from;
+    while (static_cast<int>(arrivals.size()) < packets) {
+      std::size_t size = socket.ReceiveFrom(from, data, sizeof(data));
+      if (size == 4 && std::memcmp(data, "stop", 4) == 0)
+        break;
+      arrivals.push_back(nowMicros());
+    }
+  });
+
+  std::thread senderThread([&] {
+    applyThreadRealtime(sender, sender.hubCpu, "sender");
+    if (sender.prefault)
+      prefaultStack();
+    UdpTransmitSocket out(IpEndpointName("127.0.0.1", BENCH_PORT));
+    char buffer[64];
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < packets; ++i) {
+      next += std::chrono::microseconds(SEND_INTERVAL);
+      std::this_thread::sleep_until(next);
+      osc::OutboundPacketStream p(buffer, sizeof(buffer));
+      p.WriteMessage("/myo/accel", 0.1f, 0.2f, 0.3f);
+      out.Send(p.Data(), p.Size());
+    }
+    out.Send("stop", 4);
+  });
+
+  senderThread.join();
+  receiverThread.join();
+  done = true;
+  for (auto& thread : busy)
+    thread.join();
+  return arrivals;
+}
+
+static void report(const char* name, const std::vector<int64_t>& arrivals) {
+  Jitter jitter(arrivals);
+  std::printf("%-10s %6u packets, gap %7.1f us, deviation stddev %7.1f us, p99 %7.1f us, max %8.1f us\n",
+              name, static_cast<unsigned>(arrivals.size()), jitter.mean, jitter.stddev, jitter.p99, jitter.max);
+}
+
+int main(int argc, char** argv) {
+  int seconds = argc > 1 ? std::atoi(argv[1]) : 10;
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  int busyThreads = argc > 2 ? std::atoi(argv[2]) : static_cast<int>(cores * 2);
+  std::printf("%d s per run, %d busy threads on %u cores\n", seconds, busyThreads, cores);
+
+  RealtimeSettings realtime;
+  realtime.policy = SchedPolicy::FIFO;
+  realtime.priority = 80;
+  realtime.hubCpu = 0;
+  realtime.prefault = true;
+  RealtimeSettings receiver = realtime;
+  receiver.hubCpu = cores > 1 ? 1 : 0;
+
+  report("default", runOnce(RealtimeSettings(), receiver, seconds, busyThreads));
+  lockProcessMemory();
+  report("realtime", runOnce(realtime, receiver, seconds, busyThreads));
+  return 0;
+}
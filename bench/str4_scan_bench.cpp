@@ -0,0 +1,104 @@
+// str4_scan_bench.cpp
+//
+// Cost of finding the end of OSC strings. First the scanner on its own,
+// the original word-at-a-time loop against the current block-at-a-time
+// one with its padding check, for strings of 7 to 199 characters. Then
+// validating whole messages whose cost is mostly string scanning: one with
+// a long address pattern and one with eight string arguments.
+// The block scan uses SSE2 where the compiler targets it; build again with
+// -mno-sse2 for the 64 bit word fallback.
+//
+// built from this directory, the scanner being file-static:
+//   g++ -std=gnu++11 -O2 -I.. str4_scan_bench.cpp ../osc/OscOutboundPacketStream.cpp ../osc/OscTypes.cpp
+
+#include "bench.h"
+
+#include "../osc/OscReceivedElements.cpp"
+#include "osc/OscOutboundPacketStream.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#define ITERATIONS 10000000
+#define BUFFER_SIZE 1024
+
+// the scanner as it was, which only looked at the last byte of each word
+static const char* OriginalFindStr4End(const char* p, const char* end) {
+  if (p >= end)
+    return 0;
+  if (p[0] == '\0')
+    return p + 4;
+  p += 3;
+  end -= 1;
+  while (p < end && *p)
+    p += 4;
+  if (*p)
+    return 0;
+  return p + 1;
+}
+
+static const char* scanPath() {
+#if defined(OSC_BYTE_ORDER_SSSE3) || defined(OSC_BYTE_ORDER_SSE2)
+  return "SSE2";
+#else
+  return "64 bit word";
+#endif
+}
+
+// an OSC string of length characters, padded, followed by more data
+static std::vector<char> paddedString(std::size_t length) {
+  std::vector<char> data((length / 4 + 1) * 4 + 16, '\0');
+  for (std::size_t i = 0; i < length; ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  return data;
+}
+
+int main() {
+  std::printf("scanner: %s\n", scanPath());
+  std::printf("%8s %14s %14s\n", "length", "original ns", "current ns");
+  const std::size_t lengths[] = { 7, 27, 63, 199 };
+  for (std::size_t length : lengths) {
+    std::vector<char> data = paddedString(length);
+    const char* begin = &data[0];
+    const char* end = begin + data.size();
+    if (OriginalFindStr4End(begin, end) != osc::FindStr4End(begin, end))
+      std::printf("RESULTS DIFFER\n");
+    double original = nanosPer(ITERATIONS, [&](long) {
+      keep(OriginalFindStr4End(begin, end));
+    });
+    double current = nanosPer(ITERATIONS, [&](long) {
+      keep(osc::FindStr4End(begin, end));
+    });
+    std::printf("%8u %14.1f %14.1f\n", static_cast<unsigned>(length), original, current);
+  }
+
+  char longAddress[BUFFER_SIZE];
+  osc::OutboundPacketStream p(longAddress, BUFFER_SIZE);
+  std::string address;
+  for (int i = 0; i < 8; ++i)
+    address += "/myo-osc/output";
+  p << osc::BeginMessage(address.c_str()) << 1.0f << osc::EndMessage;
+  osc::osc_bundle_element_size_t longAddressSize = static_cast<osc::osc_bundle_element_size_t>(p.Size());
+
+  char strings[BUFFER_SIZE];
+  osc::OutboundPacketStream q(strings, BUFFER_SIZE);
+  const char* label = "a label of forty characters or thereabouts";
+  q << osc::BeginMessage("/myo/labels");
+  for (int i = 0; i < 8; ++i)
+    q << label;
+  q << osc::EndMessage;
+  osc::osc_bundle_element_size_t stringsSize = static_cast<osc::osc_bundle_element_size_t>(q.Size());
+
+  double addressNanos = nanosPer(ITERATIONS / 10, [&](long) {
+    keep(osc::ReceivedPacket::Check(longAddress, longAddressSize));
+  });
+  double stringsNanos = nanosPer(ITERATIONS / 10, [&](long) {
+    keep(osc::ReceivedPacket::Check(strings, stringsSize));
+  });
+  std::printf("validating a %u character address, one float: %.1f ns\n",
+              static_cast<unsigned>(address.size()), addressNanos);
+  std::printf("validating eight %u character string arguments: %.1f ns\n",
+              static_cast<unsigned>(std::strlen(label)), stringsNanos);
+  return 0;
+}
@@ -0,0 +1,175 @@
+// osc_check_fuzzer.cpp
+//
+// Fuzz target for inbound packet validation. For every input it asserts
+// that ReceivedPacket::Check() accepts a packet exactly when the throwing
+// ReceivedBundle/ReceivedMessage constructors parse all of it within the
+// same nesting and element limits, and that OscPacketListener, which
+// parses checked packets without validating again, then sees the same
+// messages. Any disagreement aborts.
+//
+// libFuzzer, from this directory:
+//   clang++ -g -O1 -fsanitize=fuzzer,address,undefined -I.. osc_check_fuzzer.cpp
+//     ../osc/OscReceivedElements.cpp ../osc/OscPrintReceivedElements.cpp ../osc/OscTypes.cpp
+//     ../ip/IpEndpointName.cpp ../ip/posix/NetworkingUtils.cpp
+// AFL++ can build the same sources with afl-clang-fast++ and
+// -fsanitize=fuzzer. Without a fuzzing engine, -DOSC_FUZZ_STANDALONE adds
+// a main() that runs each file named on the command line, or stdin, once.
+
+#include "osc/OscPacketListener.h"
+#include "osc/OscPrintReceivedElements.h"
+#include "osc/OscReceivedElements.h"
+#include "ip/IpEndpointName.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct LimitExceeded{};
+
+// the throwing parse, recording what it finds. the limits are checked here
+// rather than by the constructors, which have none.
+void Parse( const osc::ReceivedBundle& bundle, int depth, int *elements, std::ostream& out );
+
+void Parse( const osc::ReceivedMessage& message, int *elements, std::ostream& out )
+{
+    if( ++*elements > osc::ReceivedPacket::MAX_ELEMENTS )
+        throw LimitExceeded();
+    out << message << '\n';
+}
+
+void Parse( const osc::ReceivedBundle& bundle, int depth, int *elements, std::ostream& out )
+{
+    if( ++*elements > osc::ReceivedPacket::MAX_ELEMENTS
+            || depth > osc::ReceivedPacket::MAX_BUNDLE_DEPTH )
+        throw LimitExceeded();
+    out << "bundle " << bundle.ElementCount() << '\n';
+    for( osc::ReceivedBundle::const_iterator i = bundle.ElementsBegin();
+            i != bundle.ElementsEnd(); ++i ){
+        if( i->IsBundle() )
+            Parse( osc::ReceivedBundle( *i ), depth + 1, elements, out );
+        else
+            Parse( osc::ReceivedMessage( *i ), elements, out );
+    }
+}
+
+class RecordingListener : public osc::OscPacketListener{
+public:
+    std::ostringstream out;
+    bool malformed;
+
+    RecordingListener() : malformed( false ) {}
+
+protected:
+    virtual void ProcessBundle( const osc::ReceivedBundle& b,
+            const IpEndpointName& remoteEndpoint )
+    {
+        out << "bundle " << b.ElementCount() << '\n';
+        osc::OscPacketListener::ProcessBundle( b, remoteEndpoint );
+    }
+
+    virtual void ProcessMessage( const osc::ReceivedMessage& m,
+            const IpEndpointName& remoteEndpoint )
+    {
+        (void) remoteEndpoint;
+        out << m << '\n';
+    }
+
+    virtual void ProcessMalformedPacket( const char *error,
+            const IpEndpointName& remoteEndpoint )
+    {
+        (void) error;
+        (void) remoteEndpoint;
+        malformed = true;
+    }
+};
+
+void Fail( const char *what, const uint8_t *data, size_t size )
+{
+    std::fprintf( stderr, "%s, %u bytes:", what, (unsigned)size );
+    for( size_t i=0; i < size && i < 256; ++i )
+        std::fprintf( stderr, " %02x", data[i] );
+    std::fprintf( stderr, "\n" );
+    std::abort();
+}
+
+} // namespace
+
+
+extern "C" int LLVMFuzzerTestOneInput( const uint8_t *data, size_t size )
+{
+    // the listener takes an int size
+    if( size > 0x7FFFFFFF )
+        return 0;
+    const char *contents = reinterpret_cast<const char*>(data);
+
+    const char *error = osc::ReceivedPacket::Check( contents, size );
+
+    std::ostringstream parsed;
+    bool parses = true;
+    try{
+        int elements = 0;
+        osc::ReceivedPacket packet( contents, size );
+        if( packet.IsBundle() )
+            Parse( osc::ReceivedBundle( packet ), 1, &elements, parsed );
+        else
+            Parse( osc::ReceivedMessage( packet ), &elements, parsed );
+    }catch( const osc::Exception& ){
+        parses = false;
+    }catch( const LimitExceeded& ){
+        parses = false;
+    }
+
+    if( !error && !parses )
+        Fail( "accepted by Check() but not by the throwing parse", data, size );
+    if( error && parses )
+        Fail( "rejected by Check() but parsed", data, size );
+
+    RecordingListener listener;
+    listener.ProcessPacket( contents, (int)size, IpEndpointName() );
+    if( listener.malformed != (error != 0) )
+        Fail( "the listener disagrees with Check()", data, size );
+    if( parses && listener.out.str() != parsed.str() )
+        Fail( "the listener's checked parse differs from the throwing one", data, size );
+
+    return 0;
+}
+
+
+#ifdef OSC_FUZZ_STANDALONE
+
+static void RunFile( std::FILE *file )
+{
+    std::vector<uint8_t> input;
+    uint8_t buffer[4096];
+    std::size_t n;
+    while( (n = std::fread( buffer, 1, sizeof(buffer), file )) > 0 )
+        input.insert( input.end(), buffer, buffer + n );
+    // a copy of exactly the input's size, so sanitizers see reads past it
+    std::vector<uint8_t> exact( input );
+    LLVMFuzzerTestOneInput( exact.empty() ? 0 : &exact[0], exact.size() );
+}
+
+int main( int argc, char **argv )
+{
+    if( argc < 2 ){
+        RunFile( stdin );
+        return 0;
+    }
+    for( int i=1; i < argc; ++i ){
+        std::FILE *file = std::fopen( argv[i], "rb" );
+        if( !file ){
+            std::fprintf( stderr, "can't open %s\n", argv[i] );
+            return 1;
+        }
+        RunFile( file );
+        std::fclose( file );
+    }
+    return 0;
+}
+
+#endif /* OSC_FUZZ_STANDALONE */
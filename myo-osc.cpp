@@ -15,9 +15,18 @@
 #define _CRT_SECURE_NO_WARNINGS
 #endif
 
+#include "MyoOscControl.h"
 #include "MyoOscGenerator.h"
+#include "MyoOscRealtime.h"
+#include "MyoOscTimer.h"
 
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <exception>
+#include <memory>
 #include <stdexcept>
+#include <thread>
 #include "optionparser.h"
 
 struct Arg : public option::Arg {
@@ -73,8 +82,16 @@ enum optionIndex {
   EMG,
   SYNC,
   RSSI,
+  EMGENV,
+  EMGBANDS,
+  WORLDACCEL,
+  LINEARACCEL,
+  WORLDGYRO,
+  GESTURE,
+  FRAME,
   CONSOLE,
   LOGOSC,
+  WATCH,
   HELP
 };
 enum OptionType {DISABLE, ENABLE, OTHER};
@@ -102,9 +119,24 @@ const option::Descriptor usage[] = {
   {EMG,         DISABLE,      "E",  "noemg",      Arg::None,      "--noemg Disable EMG output"},
   {RSSI,        ENABLE,       "r",  "rssi",       Arg::Optional,  "--rssi Enable RSSI (signal strength) output"},
   {RSSI,        DISABLE,      "R",  "norssi",     Arg::None,      "--norssi Disable RSSI (signal strength) output"},
+  {EMGENV,      ENABLE,       "v",  "envelope",   Arg::Optional,  "--envelope Enable EMG envelope (moving RMS and low-pass) output"},
+  {EMGENV,      DISABLE,      "V",  "noenvelope", Arg::None,      "--noenvelope Disable EMG envelope output"},
+  {EMGBANDS,    ENABLE,       "b",  "bands",      Arg::Optional,  "--bands Enable EMG band power output"},
+  {EMGBANDS,    DISABLE,      "B",  "nobands",    Arg::None,      "--nobands Disable EMG band power output"},
+  {WORLDACCEL,  ENABLE,       "",   "worldaccel", Arg::Optional,  "--worldaccel Enable world-frame accelerometer output"},
+  {WORLDACCEL,  DISABLE,      "",   "noworldaccel", Arg::None,    "--noworldaccel Disable world-frame accelerometer output"},
+  {LINEARACCEL, ENABLE,       "",   "linearaccel", Arg::Optional, "--linearaccel Enable gravity-free linear acceleration output"},
+  {LINEARACCEL, DISABLE,      "",   "nolinearaccel", Arg::None,   "--nolinearaccel Disable linear acceleration output"},
+  {WORLDGYRO,   ENABLE,       "",   "worldgyro",  Arg::Optional,  "--worldgyro Enable world-frame gyroscope output"},
+  {WORLDGYRO,   DISABLE,      "",   "noworldgyro", Arg::None,     "--noworldgyro Disable world-frame gyroscope output"},
+  {GESTURE,     ENABLE,       "",   "gesture",    Arg::Optional,  "--gesture Enable custom gesture output (needs a gesture model in the config)"},
+  {GESTURE,     DISABLE,      "",   "nogesture",  Arg::None,      "--nogesture Disable custom gesture output"},
+  {FRAME,       ENABLE,       "",   "frame",      Arg::Optional,  "--frame Enable resampled frame output (all streams on one clock)"},
+  {FRAME,       DISABLE,      "",   "noframe",    Arg::None,      "--noframe Disable resampled frame output"},
   {SYNC,        ENABLE,       "s",  "sync",       Arg::Optional,  "--sync Enable sync/unsync output"},
   {SYNC,        DISABLE,      "S",  "nosync",     Arg::None,      "--nosync Disable sync/unsync output"},
   {LOGOSC,      ENABLE,       "l",  "log",        Arg::None,      "--log Enable OSC debug logging."},
+  {WATCH,       0,            "w",  "watch",      Arg::None,      "--watch Reload the --config file whenever it changes."},
   {HELP,        0,            "",   "help",       Arg::None,      "--help Print usage and exit."},
   {0, 0, 0, 0, 0, 0},
 };
@@ -120,7 +152,8 @@ static void setArg(OutputType* type, const option::Option& opt) {
   }
 }
 
-bool parseArgs(int argc, char **argv, Settings* settings) {
+// configFile is set to the --config file if it should be watched for changes
+bool parseArgs(int argc, char **argv, Settings* settings, std::string* configFile) {
   argc-=(argc>0); argv+=(argc>0); // skip program name argv[0] if present
   option::Stats  stats(usage, argc, argv);
   std::vector<option::Option> options(stats.options_max);
@@ -138,14 +171,21 @@ bool parseArgs(int argc, char **argv, Settings* settings) {
   settings->port = 7777;
   settings->hostname = "127.0.0.1";
   settings->logOsc = false;
-  settings->accel = OutputType(false, "/myo/accel");
-  settings->gyro = OutputType(false, "/myo/gyro");
-  settings->orientation = OutputType(false, "/myo/orientation");
-  settings->orientationQuat = OutputType(false, "/myo/orientationquat");
-  settings->pose = OutputType(false, "/myo/pose");
-  settings->emg = OutputType(false, "/myo/emg");
-  settings->sync = OutputType(false, "/myo/arm");
-  settings->rssi = OutputType(false, "/myo/rssi");
+  settings->accel = OutputType(OutputId::ACCEL, false, "/myo/accel");
+  settings->gyro = OutputType(OutputId::GYRO, false, "/myo/gyro");
+  settings->orientation = OutputType(OutputId::ORIENTATION, false, "/myo/orientation");
+  settings->orientationQuat = OutputType(OutputId::ORIENTATION_QUAT, false, "/myo/orientationquat");
+  settings->pose = OutputType(OutputId::POSE, false, "/myo/pose", Priority::EVENT);
+  settings->emg = OutputType(OutputId::EMG, false, "/myo/emg");
+  settings->sync = OutputType(OutputId::SYNC, false, "/myo/arm", Priority::EVENT);
+  settings->rssi = OutputType(OutputId::RSSI, false, "/myo/rssi");
+  settings->emgEnvelope = OutputType(OutputId::EMG_ENVELOPE, false, "/myo/emg/envelope");
+  settings->emgBands = OutputType(OutputId::EMG_BANDS, false, "/myo/emg/bands");
+  settings->worldAccel = OutputType(OutputId::WORLD_ACCEL, false, "/myo/accel/world");
+  settings->linearAccel = OutputType(OutputId::LINEAR_ACCEL, false, "/myo/accel/linear");
+  settings->worldGyro = OutputType(OutputId::WORLD_GYRO, false, "/myo/gyro/world");
+  settings->gesture = OutputType(OutputId::GESTURE, false, "/myo/gesture", Priority::EVENT);
+  settings->frame = OutputType(OutputId::FRAME, false, "/myo/frame");
   
   for (const auto& opt : options) {
     switch (opt.index()) {
@@ -173,6 +213,27 @@ bool parseArgs(int argc, char **argv, Settings* settings) {
       case RSSI:
         setArg(&settings->rssi, opt);
         break;
+      case EMGENV:
+        setArg(&settings->emgEnvelope, opt);
+        break;
+      case EMGBANDS:
+        setArg(&settings->emgBands, opt);
+        break;
+      case WORLDACCEL:
+        setArg(&settings->worldAccel, opt);
+        break;
+      case LINEARACCEL:
+        setArg(&settings->linearAccel, opt);
+        break;
+      case WORLDGYRO:
+        setArg(&settings->worldGyro, opt);
+        break;
+      case GESTURE:
+        setArg(&settings->gesture, opt);
+        break;
+      case FRAME:
+        setArg(&settings->frame, opt);
+        break;
       case LOGOSC:
         settings->logOsc = opt.type() == ENABLE;
         break;
@@ -189,6 +250,8 @@ bool parseArgs(int argc, char **argv, Settings* settings) {
             std::cout << "Error reading config json" << std::endl;
             return false;
           }
+          if (options[WATCH])
+            *configFile = argStr;
         }
       }
         break;
@@ -213,13 +276,35 @@ bool parseArgs(int argc, char **argv, Settings* settings) {
   return true;
 }
 
+// whether any enabled output is computed from EMG
+static bool needsEmg(const Settings& settings) {
+  return settings.emg || settings.emgEnvelope || settings.emgBands || settings.gesture ||
+  (settings.frame && settings.frames.includes(FrameStream::EMG));
+}
+
+// whether anything needs RSSI polled
+static bool needsRssi(const Settings& settings) {
+  return settings.rssi || (settings.frame && settings.frames.includes(FrameStream::RSSI));
+}
+
+// ms to keep retrying queued packets on the way out
+#define SHUTDOWN_DRAIN_TIMEOUT 500
+
+// cleared by SIGINT/SIGTERM or when the hub thread fails
+static std::atomic<bool> running(true);
+
+extern "C" void stopRunning(int) {
+  running = false;
+}
+
 int main(int argc, char** argv)
 {
   Settings settings;
   // We catch any exceptions that might occur below -- see the catch statement for more details.
   try
   {
-    if (!parseArgs(argc, argv, &settings))
+    std::string configFile;
+    if (!parseArgs(argc, argv, &settings, &configFile))
       return 1;
     
     std::cout << settings;
@@ -247,11 +332,36 @@ int main(int argc, char** argv)
     // We've found a Myo.
     std::cout << "Connected to a Myo armband!" << std::endl << std::endl;
     
-    if (settings.emg)
+    if (settings.gesture && settings.gestures.model.classes.empty())
+      std::cerr << "No gesture model is configured, the gesture output will stay quiet" << std::endl;
+    if (needsEmg(settings))
       myo->setStreamEmg(myo::Myo::streamEmgEnabled);
     
+    // Counters shared by the listener and the stats publisher.
+    Stats stats;
+    
+    // The listener reads its settings through this, so they can be swapped while running.
+    SettingsHolder config(settings);
+    std::unique_ptr<ConfigWatcher> watcher;
+    if (!configFile.empty())
+      watcher.reset(new ConfigWatcher(configFile, settings, &config));
+    
     // Next we construct an instance of our DeviceListener, so that we can register it with the Hub.
-    MyoOscGenerator collector(settings);
+    MyoOscGenerator collector(&config, &stats);
+    
+    std::unique_ptr<StatsPublisher> statsPublisher;
+    if (settings.stats.enabled)
+      statsPublisher.reset(new StatsPublisher(stats, collector.sender->counters(), settings.stats));
+    
+    if (settings.realtime.prefault)
+      collector.prefault();
+    if (settings.realtime.lockMemory)
+      lockProcessMemory();
+    
+    // Calibration commands and the like come in here.
+    std::unique_ptr<ControlReceiver> control;
+    if (settings.control.enabled)
+      control.reset(new ControlReceiver(settings.control, &collector.calibration));
     
     // Hub::addListener() takes the address of any object whose class inherits from DeviceListener, and will cause
     // Hub::run() to send events to all registered device listeners.
@@ -259,16 +369,106 @@ int main(int argc, char** argv)
     
     myo->unlock(myo::Myo::unlockHold);
     
-    // Finally we enter our main loop.
-    while (1) {
-      // In each iteration of our main loop, we run the Myo event loop for a set number of milliseconds.
-      // In this case, we wish to update our display 20 times a second, so we run for 1000/20 milliseconds.
-      hub.run(1000/20);
-      if (settings.rssi) {
+    std::signal(SIGINT, stopRunning);
+    std::signal(SIGTERM, stopRunning);
+    
+    // RSSI can be switched on and off by a config reload, the hub thread keeps this up to date
+    std::atomic<bool> rssiEnabled(needsRssi(settings));
+    
+    // Periodic work runs on the timer thread at its own rate.
+    TimerThread timer;
+    timer.setThreadInit([&settings] {
+      applyThreadRealtime(settings.realtime, settings.realtime.timerCpu, "timer");
+    });
+    timer.add(settings.hub.rssiInterval, [myo, &rssiEnabled] {
+      if (rssiEnabled)
         myo->requestRssi();
-      }
+    });
+    if (statsPublisher)
+      timer.add(settings.stats.interval, [&statsPublisher] { statsPublisher->publish(); });
+    std::unique_ptr<UdpTransmitSocket> keepAliveSocket;
+    char keepAliveBuffer[64];
+    if (settings.hub.keepAlive > 0) {
+      keepAliveSocket.reset(new UdpTransmitSocket(IpEndpointName(settings.hostname.c_str(), settings.port)));
+      timer.add(settings.hub.keepAlive, [&] {
+        osc::OutboundPacketStream p(keepAliveBuffer, sizeof(keepAliveBuffer));
+        p << osc::BeginMessage("/myo-osc/alive") << osc::EndMessage;
+        keepAliveSocket->TrySend(p.Data(), p.Size());
+      });
     }
     
+    // The hub gets a thread of its own, so event delivery isn't held up by anything else we do.
+    // Each slice runs the Myo event loop for settings.hub.slice milliseconds, or until the first
+    // event with runOnce.
+    std::exception_ptr hubError;
+    bool emgEnabled = needsEmg(settings);
+    if (collector.pacer) {
+      collector.pacer->setThreadInit([&settings] {
+        applyThreadRealtime(settings.realtime, settings.realtime.pacerCpu, "pacer");
+      });
+      collector.pacer->start();
+    }
+    std::thread hubThread([&] {
+      applyThreadRealtime(settings.realtime, settings.realtime.hubCpu, "hub");
+      if (settings.realtime.prefault)
+        prefaultStack();
+      try {
+        while (running) {
+          auto sliceStart = std::chrono::steady_clock::now();
+          if (settings.hub.runOnce)
+            hub.runOnce(settings.hub.slice);
+          else
+            hub.run(settings.hub.slice);
+          // anything an unfinished event left in the bundle
+          collector.flush();
+          // and anything the socket turned away, which would otherwise wait
+          // for the next send. the pacer thread does this when pacing is on.
+          if (!collector.pacer)
+            collector.sender->flush();
+          stats.recordSlice(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sliceStart).count());
+          
+          // no callback is running, so earlier snapshots can be released
+          config.quiescent();
+          const Settings* current = config.get();
+          if (needsEmg(*current) != emgEnabled) {
+            emgEnabled = !emgEnabled;
+            myo->setStreamEmg(emgEnabled ? myo::Myo::streamEmgEnabled : myo::Myo::streamEmgDisabled);
+          }
+          rssiEnabled = needsRssi(*current);
+        }
+      } catch (...) {
+        hubError = std::current_exception();
+        running = false;
+      }
+    });
+    timer.start();
+    if (watcher)
+      watcher->start();
+    if (control)
+      control->start();
+    
+    while (running)
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    
+    if (control)
+      control->stop();
+    if (watcher)
+      watcher->stop();
+    timer.stop();
+    hubThread.join();
+    // sends anything still being held
+    if (collector.pacer)
+      collector.pacer->stop();
+    hub.removeListener(&collector);
+    // nothing else is sending now, give queued packets a last chance
+    if (!collector.sender->drain(SHUTDOWN_DRAIN_TIMEOUT))
+      std::cerr << "Gave up on " << collector.sender->queued() << " queued packets" << std::endl;
+    if (hubError)
+      std::rethrow_exception(hubError);
+    
+    std::cout << "Stopped, " << collector.sender->counters() << std::endl;
+    return 0;
+    
     // If a standard exception occurred, we print out its message and exit.
   } catch (const std::exception& e) {
     std::cerr << "Error: " << e.what() << std::endl;
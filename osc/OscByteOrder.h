@@ -0,0 +1,145 @@
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#ifndef INCLUDED_OSCPACK_OSCBYTEORDER_H
+#define INCLUDED_OSCPACK_OSCBYTEORDER_H
+
+/*
+    Conversion between host and OSC (big endian) byte order for runs of
+    32 bit values, as found in messages of many floats or int32s. Whole
+    runs are swapped with SSSE3 pshufb, SSE2 shifts and shuffles or NEON
+    vrev32 where the compiler targets them, a word at a time otherwise.
+*/
+
+#include <cstddef> // size_t
+#include <cstring> // memcpy
+
+#include "OscHostEndianness.h"
+#include "OscTypes.h"
+
+#if defined(OSC_HOST_LITTLE_ENDIAN)
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define OSC_BYTE_ORDER_SSSE3
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OSC_BYTE_ORDER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define OSC_BYTE_ORDER_NEON
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <stdlib.h> // _byteswap_ulong
+#endif
+
+namespace osc{
+
+inline uint32 SwapBytes32( uint32 x )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32( x );
+#elif defined(_MSC_VER)
+    return _byteswap_ulong( x );
+#else
+    return (x >> 24) | ((x >> 8) & 0xFF00) | ((x << 8) & 0xFF0000) | (x << 24);
+#endif
+}
+
+
+// a 32 or 64 bit value in OSC byte order at p, which needn't be aligned
+inline uint32 LoadBigEndian32( const char *p )
+{
+    uint32 x;
+    std::memcpy( &x, p, 4 );
+#ifdef OSC_HOST_LITTLE_ENDIAN
+    x = SwapBytes32( x );
+#endif
+    return x;
+}
+
+
+inline uint64 LoadBigEndian64( const char *p )
+{
+    return ((uint64)LoadBigEndian32( p ) << 32) | LoadBigEndian32( p + 4 );
+}
+
+
+// copies count 32 bit values from src to dest, converting from host to OSC
+// byte order or back, the conversion is the same both ways. neither pointer
+// needs to be aligned, but the ranges must not overlap.
+inline void CopySwapped32( char *dest, const char *src, std::size_t count )
+{
+#ifdef OSC_HOST_LITTLE_ENDIAN
+    std::size_t i = 0;
+
+#if defined(OSC_BYTE_ORDER_SSSE3)
+    const __m128i reverse = _mm_set_epi8( 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3 );
+    for( ; i + 4 <= count; i += 4 ){
+        __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i * 4 ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dest + i * 4 ), _mm_shuffle_epi8( v, reverse ) );
+    }
+#elif defined(OSC_BYTE_ORDER_SSE2)
+    for( ; i + 4 <= count; i += 4 ){
+        __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i * 4 ) );
+        // swap the bytes of each 16 bit half, then the halves
+        v = _mm_or_si128( _mm_slli_epi16( v, 8 ), _mm_srli_epi16( v, 8 ) );
+        v = _mm_shufflelo_epi16( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+        v = _mm_shufflehi_epi16( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dest + i * 4 ), v );
+    }
+#elif defined(OSC_BYTE_ORDER_NEON)
+    for( ; i + 4 <= count; i += 4 ){
+        uint8x16_t v = vld1q_u8( reinterpret_cast<const uint8_t*>( src + i * 4 ) );
+        vst1q_u8( reinterpret_cast<uint8_t*>( dest + i * 4 ), vrev32q_u8( v ) );
+    }
+#endif
+
+    for( ; i < count; ++i ){
+        uint32 x;
+        std::memcpy( &x, src + i * 4, 4 );
+        x = SwapBytes32( x );
+        std::memcpy( dest + i * 4, &x, 4 );
+    }
+#else
+    std::memcpy( dest, src, count * 4 );
+#endif
+}
+
+} // namespace osc
+
+#endif /* INCLUDED_OSCPACK_OSCBYTEORDER_H */
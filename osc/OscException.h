@@ -1,62 +1,108 @@
-/*
-	oscpack -- Open Sound Control (OSC) packet manipulation library
-    http://www.rossbencina.com/code/oscpack
-
-    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
-
-	Permission is hereby granted, free of charge, to any person obtaining
-	a copy of this software and associated documentation files
-	(the "Software"), to deal in the Software without restriction,
-	including without limitation the rights to use, copy, modify, merge,
-	publish, distribute, sublicense, and/or sell copies of the Software,
-	and to permit persons to whom the Software is furnished to do so,
-	subject to the following conditions:
-
-	The above copyright notice and this permission notice shall be
-	included in all copies or substantial portions of the Software.
-
-	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
-	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
-	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
-	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
-	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
-	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-*/
-
-/*
-	The text above constitutes the entire oscpack license; however, 
-	the oscpack developer(s) also make the following non-binding requests:
-
-	Any person wishing to distribute modifications to the Software is
-	requested to send the modifications to the original developer so that
-	they can be incorporated into the canonical version. It is also 
-	requested that these non-binding requests be included whenever the
-	above license is reproduced.
-*/
-#ifndef INCLUDED_OSCPACK_OSCEXCEPTION_H
-#define INCLUDED_OSCPACK_OSCEXCEPTION_H
-
-#include <exception>
-
-namespace osc{
-
-class Exception : public std::exception {
-    const char *what_;
-    
-public:
-    Exception() throw() {}
-    Exception( const Exception& src ) throw()
-        : std::exception( src )
-        , what_( src.what_ ) {}
-    Exception( const char *w ) throw()
-        : what_( w ) {}
-    Exception& operator=( const Exception& src ) throw()
-        { what_ = src.what_; return *this; }
-    virtual ~Exception() throw() {}
-    virtual const char* what() const throw() { return what_; }
-};
-
-} // namespace osc
-
-#endif /* INCLUDED_OSCPACK_OSCEXCEPTION_H */
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#ifndef INCLUDED_OSCPACK_OSCEXCEPTION_H
+#define INCLUDED_OSCPACK_OSCEXCEPTION_H
+
+#include <exception>
+
+/*
+    Define OSC_NO_EXCEPTIONS to build without exceptions, which happens
+    anyway when the compiler has them turned off (-fno-exceptions). Errors
+    that would have thrown then go to ThrowError() below, which reports
+    them and aborts, so code that has to survive bad input should use the
+    non-throwing paths: OutboundPacketStream's sticky error state and
+    ReceivedPacket::Check().
+*/
+#if !defined(OSC_NO_EXCEPTIONS) && \
+        ((defined(__GNUC__) && !defined(__EXCEPTIONS)) || \
+         (defined(_MSC_VER) && !defined(_CPPUNWIND)))
+#define OSC_NO_EXCEPTIONS
+#endif
+
+#ifdef OSC_NO_EXCEPTIONS
+#include <cstdio>
+#include <cstdlib>
+#endif
+
+namespace osc{
+
+class Exception : public std::exception {
+    const char *what_;
+    
+public:
+    Exception() throw() {}
+    Exception( const Exception& src ) throw()
+        : std::exception( src )
+        , what_( src.what_ ) {}
+    Exception( const char *w ) throw()
+        : what_( w ) {}
+    Exception& operator=( const Exception& src ) throw()
+        { what_ = src.what_; return *this; }
+    virtual ~Exception() throw() {}
+    virtual const char* what() const throw() { return what_; }
+};
+
+
+#ifdef OSC_NO_EXCEPTIONS
+
+// tells the compiler ThrowError() doesn't return, so functions that end in
+// OSC_THROW don't warn about a missing return value
+#if defined(__GNUC__) || defined(__clang__)
+#define OSC_NORETURN __attribute__((noreturn))
+#elif defined(_MSC_VER)
+#define OSC_NORETURN __declspec(noreturn)
+#else
+#define OSC_NORETURN
+#endif
+
+OSC_NORETURN inline void ThrowError( const Exception& e )
+{
+    std::fprintf( stderr, "oscpack: %s\n", e.what() );
+    std::abort();
+}
+
+#define OSC_THROW( e ) ::osc::ThrowError( e )
+
+#else
+
+#define OSC_THROW( e ) throw e
+
+#endif
+
+} // namespace osc
+
+#endif /* INCLUDED_OSCPACK_OSCEXCEPTION_H */
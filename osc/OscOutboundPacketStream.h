@@ -1,154 +1,395 @@
-/*
-	oscpack -- Open Sound Control (OSC) packet manipulation library
-    http://www.rossbencina.com/code/oscpack
-
-    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
-
-	Permission is hereby granted, free of charge, to any person obtaining
-	a copy of this software and associated documentation files
-	(the "Software"), to deal in the Software without restriction,
-	including without limitation the rights to use, copy, modify, merge,
-	publish, distribute, sublicense, and/or sell copies of the Software,
-	and to permit persons to whom the Software is furnished to do so,
-	subject to the following conditions:
-
-	The above copyright notice and this permission notice shall be
-	included in all copies or substantial portions of the Software.
-
-	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
-	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
-	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
-	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
-	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
-	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-*/
-
-/*
-	The text above constitutes the entire oscpack license; however, 
-	the oscpack developer(s) also make the following non-binding requests:
-
-	Any person wishing to distribute modifications to the Software is
-	requested to send the modifications to the original developer so that
-	they can be incorporated into the canonical version. It is also 
-	requested that these non-binding requests be included whenever the
-	above license is reproduced.
-*/
-#ifndef INCLUDED_OSCPACK_OSCOUTBOUNDPACKETSTREAM_H
-#define INCLUDED_OSCPACK_OSCOUTBOUNDPACKETSTREAM_H
-
-#include <cstring> // size_t
-
-#include "OscTypes.h"
-#include "OscException.h"
-
-
-namespace osc{
-
-class OutOfBufferMemoryException : public Exception{
-public:
-    OutOfBufferMemoryException( const char *w="out of buffer memory" )
-        : Exception( w ) {}
-};
-
-class BundleNotInProgressException : public Exception{
-public:
-    BundleNotInProgressException(
-            const char *w="call to EndBundle when bundle is not in progress" )
-        : Exception( w ) {}
-};
-
-class MessageInProgressException : public Exception{
-public:
-    MessageInProgressException(
-            const char *w="opening or closing bundle or message while message is in progress" )
-        : Exception( w ) {}
-};
-
-class MessageNotInProgressException : public Exception{
-public:
-    MessageNotInProgressException(
-            const char *w="call to EndMessage when message is not in progress" )
-        : Exception( w ) {}
-};
-
-
-class OutboundPacketStream{
-public:
-	OutboundPacketStream( char *buffer, std::size_t capacity );
-	~OutboundPacketStream();
-
-    void Clear();
-
-    std::size_t Capacity() const;
-
-    // invariant: size() is valid even while building a message.
-    std::size_t Size() const;
-
-    const char *Data() const;
-
-    // indicates that all messages have been closed with a matching EndMessage
-    // and all bundles have been closed with a matching EndBundle
-    bool IsReady() const;
-
-    bool IsMessageInProgress() const;
-    bool IsBundleInProgress() const;
-
-    OutboundPacketStream& operator<<( const BundleInitiator& rhs );
-    OutboundPacketStream& operator<<( const BundleTerminator& rhs );
-    
-    OutboundPacketStream& operator<<( const BeginMessage& rhs );
-    OutboundPacketStream& operator<<( const MessageTerminator& rhs );
-
-    OutboundPacketStream& operator<<( bool rhs );
-    OutboundPacketStream& operator<<( const NilType& rhs );
-    OutboundPacketStream& operator<<( const InfinitumType& rhs );
-    OutboundPacketStream& operator<<( int32 rhs );
-
-#if !(defined(__x86_64__) || defined(_M_X64))
-    OutboundPacketStream& operator<<( int rhs )
-            { *this << (int32)rhs; return *this; }
-#endif
-
-    OutboundPacketStream& operator<<( float rhs );
-    OutboundPacketStream& operator<<( char rhs );
-    OutboundPacketStream& operator<<( const RgbaColor& rhs );
-    OutboundPacketStream& operator<<( const MidiMessage& rhs );
-    OutboundPacketStream& operator<<( int64 rhs );
-    OutboundPacketStream& operator<<( const TimeTag& rhs );
-    OutboundPacketStream& operator<<( double rhs );
-    OutboundPacketStream& operator<<( const char* rhs );
-    OutboundPacketStream& operator<<( const Symbol& rhs );
-    OutboundPacketStream& operator<<( const Blob& rhs );
-
-    OutboundPacketStream& operator<<( const ArrayInitiator& rhs );
-    OutboundPacketStream& operator<<( const ArrayTerminator& rhs );
-
-private:
-
-    char *BeginElement( char *beginPtr );
-    void EndElement( char *endPtr );
-
-    bool ElementSizeSlotRequired() const;
-    void CheckForAvailableBundleSpace();
-    void CheckForAvailableMessageSpace( const char *addressPattern );
-    void CheckForAvailableArgumentSpace( std::size_t argumentLength );
-
-    char *data_;
-    char *end_;
-
-    char *typeTagsCurrent_; // stored in reverse order
-    char *messageCursor_;
-    char *argumentCurrent_;
-
-    // elementSizePtr_ has two special values: 0 indicates that a bundle
-    // isn't open, and elementSizePtr_==data_ indicates that a bundle is
-    // open but that it doesn't have a size slot (ie the outermost bundle)
-    uint32 *elementSizePtr_;
-
-    bool messageIsInProgress_;
-};
-
-} // namespace osc
-
-#endif /* INCLUDED_OSCPACK_OSCOUTBOUNDPACKETSTREAM_H */
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#ifndef INCLUDED_OSCPACK_OSCOUTBOUNDPACKETSTREAM_H
+#define INCLUDED_OSCPACK_OSCOUTBOUNDPACKETSTREAM_H
+
+#include <cstddef> // size_t
+#include <cstring> // memcpy, memset, strlen
+
+#include "OscByteOrder.h"
+#include "OscHostEndianness.h"
+#include "OscTypes.h"
+#include "OscException.h"
+
+
+namespace osc{
+
+class OutOfBufferMemoryException : public Exception{
+public:
+    OutOfBufferMemoryException( const char *w="out of buffer memory" )
+        : Exception( w ) {}
+};
+
+class BundleNotInProgressException : public Exception{
+public:
+    BundleNotInProgressException(
+            const char *w="call to EndBundle when bundle is not in progress" )
+        : Exception( w ) {}
+};
+
+class MessageInProgressException : public Exception{
+public:
+    MessageInProgressException(
+            const char *w="opening or closing bundle or message while message is in progress" )
+        : Exception( w ) {}
+};
+
+class MessageNotInProgressException : public Exception{
+public:
+    MessageNotInProgressException(
+            const char *w="call to EndMessage when message is not in progress" )
+        : Exception( w ) {}
+};
+
+
+// type tag for each argument type accepted by OutboundPacketStream::WriteMessage
+template< typename T > struct TypeTagTraits;
+
+template<> struct TypeTagTraits< int32 >{ static const char tag = INT32_TYPE_TAG; };
+#if !(defined(__x86_64__) || defined(_M_X64))
+template<> struct TypeTagTraits< int >{ static const char tag = INT32_TYPE_TAG; };
+#endif
+template<> struct TypeTagTraits< float >{ static const char tag = FLOAT_TYPE_TAG; };
+template<> struct TypeTagTraits< char >{ static const char tag = CHAR_TYPE_TAG; };
+template<> struct TypeTagTraits< RgbaColor >{ static const char tag = RGBA_COLOR_TYPE_TAG; };
+template<> struct TypeTagTraits< MidiMessage >{ static const char tag = MIDI_MESSAGE_TYPE_TAG; };
+template<> struct TypeTagTraits< int64 >{ static const char tag = INT64_TYPE_TAG; };
+template<> struct TypeTagTraits< TimeTag >{ static const char tag = TIME_TAG_TYPE_TAG; };
+template<> struct TypeTagTraits< double >{ static const char tag = DOUBLE_TYPE_TAG; };
+template<> struct TypeTagTraits< const char* >{ static const char tag = STRING_TYPE_TAG; };
+template<> struct TypeTagTraits< char* >{ static const char tag = STRING_TYPE_TAG; };
+template< std::size_t N > struct TypeTagTraits< char[N] >{ static const char tag = STRING_TYPE_TAG; };
+template<> struct TypeTagTraits< Symbol >{ static const char tag = SYMBOL_TYPE_TAG; };
+template<> struct TypeTagTraits< Blob >{ static const char tag = BLOB_TYPE_TAG; };
+
+// the complete, zero padded type tag string for a list of argument types,
+// built at compile time
+template< typename... Args >
+struct TypeTagString{
+    static const char value[ (sizeof...(Args) + 2 + 3) & ~(std::size_t)0x03 ];
+};
+
+template< typename... Args >
+const char TypeTagString< Args... >::value[ (sizeof...(Args) + 2 + 3) & ~(std::size_t)0x03 ] =
+        { ',', TypeTagTraits< Args >::tag..., '\0' };
+
+// the type tag string for N arguments of the same type, built up one tag at a
+// time into Tags
+template< char Tag, std::size_t N, char... Tags >
+struct RepeatedTypeTagString : RepeatedTypeTagString< Tag, N - 1, Tag, Tags... > {};
+
+template< char Tag, char... Tags >
+struct RepeatedTypeTagString< Tag, 0, Tags... >{
+    static const char value[ (sizeof...(Tags) + 2 + 3) & ~(std::size_t)0x03 ];
+};
+
+template< char Tag, char... Tags >
+const char RepeatedTypeTagString< Tag, 0, Tags... >::value[ (sizeof...(Tags) + 2 + 3) & ~(std::size_t)0x03 ] =
+        { ',', Tags..., '\0' };
+
+
+class OutboundPacketStream{
+public:
+	OutboundPacketStream( char *buffer, std::size_t capacity );
+	~OutboundPacketStream();
+
+    void Clear();
+
+    std::size_t Capacity() const;
+
+    // invariant: size() is valid even while building a message.
+    std::size_t Size() const;
+
+    const char *Data() const;
+
+    // indicates that all messages have been closed with a matching EndMessage
+    // and all bundles have been closed with a matching EndBundle
+    bool IsReady() const;
+
+    bool IsMessageInProgress() const;
+    bool IsBundleInProgress() const;
+
+    // Without exceptions (OSC_NO_EXCEPTIONS), or after
+    // SetThrowOnError( false ), a write that doesn't fit or comes out of
+    // order sets a sticky error instead of throwing, and every write after
+    // it is ignored until Clear(). A packet can then be written without
+    // checks and tested once at the end.
+    void SetThrowOnError( bool throwOnError ) { throwOnError_ = throwOnError; }
+    bool IsOk() const { return error_ == 0; }
+    // what went wrong first, 0 if IsOk()
+    const char *Error() const { return error_; }
+
+    // Drops everything written after the stream was size bytes long, along
+    // with any error, e.g. to take back a message that didn't fit while
+    // keeping the rest of the bundle. size must be a Size() taken while no
+    // message was in progress, and every bundle open then must still be.
+    void Rewind( std::size_t size );
+
+    OutboundPacketStream& operator<<( const BundleInitiator& rhs );
+    OutboundPacketStream& operator<<( const BundleTerminator& rhs );
+    
+    OutboundPacketStream& operator<<( const BeginMessage& rhs );
+    OutboundPacketStream& operator<<( const MessageTerminator& rhs );
+
+    OutboundPacketStream& operator<<( bool rhs );
+    OutboundPacketStream& operator<<( const NilType& rhs );
+    OutboundPacketStream& operator<<( const InfinitumType& rhs );
+    OutboundPacketStream& operator<<( int32 rhs );
+
+#if !(defined(__x86_64__) || defined(_M_X64))
+    OutboundPacketStream& operator<<( int rhs )
+            { *this << (int32)rhs; return *this; }
+#endif
+
+    OutboundPacketStream& operator<<( float rhs );
+    OutboundPacketStream& operator<<( char rhs );
+    OutboundPacketStream& operator<<( const RgbaColor& rhs );
+    OutboundPacketStream& operator<<( const MidiMessage& rhs );
+    OutboundPacketStream& operator<<( int64 rhs );
+    OutboundPacketStream& operator<<( const TimeTag& rhs );
+    OutboundPacketStream& operator<<( double rhs );
+    OutboundPacketStream& operator<<( const char* rhs );
+    OutboundPacketStream& operator<<( const Symbol& rhs );
+    OutboundPacketStream& operator<<( const Blob& rhs );
+
+    OutboundPacketStream& operator<<( const ArrayInitiator& rhs );
+    OutboundPacketStream& operator<<( const ArrayTerminator& rhs );
+
+    // Append count float or int32 arguments to the message in progress,
+    // equivalent to streaming each in turn but with one space check and the
+    // whole run converted to OSC byte order at once.
+    OutboundPacketStream& WriteFloats( const float *values, std::size_t count );
+    OutboundPacketStream& WriteInt32s( const int32 *values, std::size_t count );
+
+    // Append an OSC array of count floats, equivalent to streaming
+    // BeginArray, each value and EndArray, with the tags and payload
+    // written in one step.
+    OutboundPacketStream& WriteFloatArray( const float *values, std::size_t count );
+
+    // Writes a complete message in a single forward pass, equivalent to
+    // << BeginMessage( addressPattern ) << args... << EndMessage. The type
+    // tags are known at compile time, so they're written in place rather
+    // than collected backwards and moved in front of the arguments, and the
+    // space for the whole message is checked once. Arguments may be int32,
+    // float, char, RgbaColor, MidiMessage, int64, TimeTag, double, strings,
+    // Symbol and Blob; bool, nil, infinitum and arrays need the stream
+    // operators.
+    template< typename... Args >
+    OutboundPacketStream& WriteMessage( const char *addressPattern, const Args&... args )
+    {
+        std::size_t argumentSizes[] = { 0, ArgumentSize( args )... };
+        std::size_t argumentsSize = 0;
+        for( std::size_t i=1; i < sizeof(argumentSizes) / sizeof(argumentSizes[0]); ++i )
+            argumentsSize += argumentSizes[i];
+
+        char *p = BeginWrite( addressPattern, TypeTagString< Args... >::value,
+                sizeof(TypeTagString< Args... >::value), argumentsSize );
+        if( !p )
+            return *this;
+
+        // braced initializers are evaluated in order
+        char *written[] = { p, (p = WriteArgument( p, args ))... };
+        (void) written;
+
+        EndWrite( p );
+        return *this;
+    }
+
+    // As WriteMessage, for a message of N fixed size arguments of the same
+    // type, such as a frame of samples. N is known at compile time so the
+    // stores unroll.
+    template< std::size_t N, typename T >
+    OutboundPacketStream& WriteRepeatedMessage( const char *addressPattern, const T *values )
+    {
+        typedef RepeatedTypeTagString< TypeTagTraits< T >::tag, N > TypeTags;
+
+        char *p = BeginWrite( addressPattern, TypeTags::value,
+                sizeof(TypeTags::value), N * ArgumentSize( values[0] ) );
+        if( !p )
+            return *this;
+        for( std::size_t i=0; i < N; ++i )
+            p = WriteArgument( p, values[i] );
+
+        EndWrite( p );
+        return *this;
+    }
+
+private:
+
+    static std::size_t PaddedSize( std::size_t x )
+            { return (x + 3) & ~((std::size_t)0x03); }
+
+    // checks for space and writes the address and type tags of a message
+    // whose arguments take argumentsSize bytes, returning where they go, or
+    // 0 if the stream has failed
+    char *BeginWrite( const char *addressPattern,
+            const char *typeTags, std::size_t typeTagsSize, std::size_t argumentsSize );
+    void EndWrite( char *end );
+
+    // swapped in a register and stored whole. storing a byte at a time
+    // through char* would make compilers reload the source after every byte.
+    static void StoreUInt32( char *p, uint32 x )
+    {
+#ifdef OSC_HOST_LITTLE_ENDIAN
+        x = SwapBytes32( x );
+#endif
+        std::memcpy( p, &x, 4 );
+    }
+
+    static void StoreUInt64( char *p, uint64 x )
+    {
+#ifdef OSC_HOST_LITTLE_ENDIAN
+        StoreUInt32( p, (uint32)(x >> 32) );
+        StoreUInt32( p + 4, (uint32)x );
+#else
+        std::memcpy( p, &x, 8 );
+#endif
+    }
+
+    static std::size_t ArgumentSize( int32 ) { return 4; }
+#if !(defined(__x86_64__) || defined(_M_X64))
+    static std::size_t ArgumentSize( int ) { return 4; }
+#endif
+    static std::size_t ArgumentSize( float ) { return 4; }
+    static std::size_t ArgumentSize( char ) { return 4; }
+    static std::size_t ArgumentSize( const RgbaColor& ) { return 4; }
+    static std::size_t ArgumentSize( const MidiMessage& ) { return 4; }
+    static std::size_t ArgumentSize( int64 ) { return 8; }
+    static std::size_t ArgumentSize( const TimeTag& ) { return 8; }
+    static std::size_t ArgumentSize( double ) { return 8; }
+    static std::size_t ArgumentSize( const char *rhs )
+            { return PaddedSize( std::strlen(rhs) + 1 ); }
+    static std::size_t ArgumentSize( const Symbol& rhs )
+            { return PaddedSize( std::strlen(rhs.value) + 1 ); }
+    static std::size_t ArgumentSize( const Blob& rhs )
+            { return 4 + PaddedSize( rhs.size ); }
+
+    static char *WriteArgument( char *p, int32 rhs )
+            { StoreUInt32( p, (uint32)rhs ); return p + 4; }
+#if !(defined(__x86_64__) || defined(_M_X64))
+    static char *WriteArgument( char *p, int rhs )
+            { StoreUInt32( p, (uint32)rhs ); return p + 4; }
+#endif
+    static char *WriteArgument( char *p, float rhs )
+    {
+        uint32 bits;
+        std::memcpy( &bits, &rhs, 4 );
+        StoreUInt32( p, bits );
+        return p + 4;
+    }
+    static char *WriteArgument( char *p, char rhs )
+            { StoreUInt32( p, (uint32)(int32)rhs ); return p + 4; }
+    static char *WriteArgument( char *p, const RgbaColor& rhs )
+            { StoreUInt32( p, rhs.value ); return p + 4; }
+    static char *WriteArgument( char *p, const MidiMessage& rhs )
+            { StoreUInt32( p, rhs.value ); return p + 4; }
+    static char *WriteArgument( char *p, int64 rhs )
+            { StoreUInt64( p, (uint64)rhs ); return p + 8; }
+    static char *WriteArgument( char *p, const TimeTag& rhs )
+            { StoreUInt64( p, rhs.value ); return p + 8; }
+    static char *WriteArgument( char *p, double rhs )
+    {
+        uint64 bits;
+        std::memcpy( &bits, &rhs, 8 );
+        StoreUInt64( p, bits );
+        return p + 8;
+    }
+    static char *WriteArgument( char *p, const char *rhs )
+    {
+        std::size_t length = std::strlen( rhs );
+        std::size_t size = PaddedSize( length + 1 );
+        std::memset( p + size - 4, 0, 4 );
+        std::memcpy( p, rhs, length );
+        return p + size;
+    }
+    static char *WriteArgument( char *p, const Symbol& rhs )
+            { return WriteArgument( p, rhs.value ); }
+    static char *WriteArgument( char *p, const Blob& rhs )
+    {
+        StoreUInt32( p, rhs.size );
+        p += 4;
+        std::size_t size = PaddedSize( rhs.size );
+        if( size != (std::size_t)rhs.size )
+            std::memset( p + size - 4, 0, 4 );
+        std::memcpy( p, rhs.data, rhs.size );
+        return p + size;
+    }
+
+
+    char *BeginElement( char *beginPtr );
+    void EndElement( char *endPtr );
+
+    bool ElementSizeSlotRequired() const;
+    // false, once the stream has failed, if there isn't the space
+    bool CheckForAvailableBundleSpace();
+    bool CheckForAvailableMessageSpace( const char *addressPattern );
+    bool CheckForAvailableArgumentSpace( std::size_t argumentLength, std::size_t typeTagCount = 1 );
+
+    // throws e, or records it as the stream's error and returns false
+    template< typename E >
+    bool Fail( const E& e )
+    {
+#ifndef OSC_NO_EXCEPTIONS
+        if( throwOnError_ )
+            throw e;
+#endif
+        if( !error_ )
+            error_ = e.what();
+        return false;
+    }
+
+    char *data_;
+    char *end_;
+
+    char *typeTagsCurrent_; // stored in reverse order
+    char *messageCursor_;
+    char *argumentCurrent_;
+
+    // elementSizePtr_ has two special values: 0 indicates that a bundle
+    // isn't open, and elementSizePtr_==data_ indicates that a bundle is
+    // open but that it doesn't have a size slot (ie the outermost bundle)
+    uint32 *elementSizePtr_;
+
+    bool messageIsInProgress_;
+
+    const char *error_;
+    bool throwOnError_;
+};
+
+} // namespace osc
+
+#endif /* INCLUDED_OSCPACK_OSCOUTBOUNDPACKETSTREAM_H */
@@ -0,0 +1,81 @@
+// clock_test.cpp
+//
+// Drives ClockTranslator with synthetic timestamps: a Myo clock running
+// 50ppm slow against the host, arrivals delayed by a fixed 500us plus
+// exponentially distributed jitter (mean 3ms), and a 1s step of the host
+// clock halfway through. Checks the drift estimate and the error of
+// toHost() against the true sampling time. The fixed part of the latency
+// can't be observed, so errors are measured from the true time plus it.
+//
+// built from this directory with the Myo SDK's include directory:
+//   g++ -std=gnu++11 -O2 -I.. -I../libs -I<Myo SDK>/include clock_test.cpp
+//     ../MyoOscClock.cpp ../MyoOscSettings.cpp ../MyoOscFilter.cpp ../MyoOscGesture.cpp
+
+#include "MyoOscClock.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// 50Hz IMU events
+#define EVENT_INTERVAL 20000
+#define DRIFT 50e-6
+#define FIXED_LATENCY 500
+#define MEAN_JITTER 3000
+#define STEP 1000000
+
+static int failures = 0;
+
+static void check(bool ok, const char* what, double value) {
+  std::printf("%-48s %14.2f %s\n", what, value, ok ? "ok" : "FAILED");
+  if (!ok)
+    ++failures;
+}
+
+int main() {
+  ClockTranslator clock;
+  TimeTagSettings settings;
+  clock.configure(settings);
+
+  std::mt19937 rng(1);
+  std::exponential_distribution<double> jitter(1.0 / MEAN_JITTER);
+  const int64_t hostBase = 1700000000000000LL;
+  const uint64_t deviceBase = 123456789;
+  // ten minutes, the step after five
+  const int events = 50 * 600;
+  const int stepAt = events / 2;
+  // how long the fit gets to settle after a start or a step
+  const int settle = 50 * 60;
+
+  double maxError = 0;
+  double maxErrorAfterStep = 0;
+  double driftBeforeStep = 0;
+  for (int i = 0; i < events; ++i) {
+    uint64_t device = deviceBase + static_cast<uint64_t>(i) * EVENT_INTERVAL;
+    double host = hostBase + static_cast<double>(device - deviceBase) * (1 + DRIFT);
+    if (i >= stepAt)
+      host += STEP;
+    clock.observe(device, static_cast<int64_t>(host + FIXED_LATENCY + jitter(rng)));
+
+    double error = std::fabs(clock.toHost(device) - (host + FIXED_LATENCY));
+    if (i == stepAt - 1)
+      driftBeforeStep = clock.drift();
+    if (i >= settle && i < stepAt)
+      maxError = std::fmax(maxError, error);
+    if (i >= stepAt + settle)
+      maxErrorAfterStep = std::fmax(maxErrorAfterStep, error);
+  }
+
+  check(std::fabs(driftBeforeStep - DRIFT * 1e6) < 2, "drift before the step, 50 +- 2 ppm",
+        driftBeforeStep);
+  check(maxError < 300, "max error once settled, < 300 us", maxError);
+  check(std::fabs(clock.drift() - DRIFT * 1e6) < 2, "drift at the end, 50 +- 2 ppm", clock.drift());
+  check(maxErrorAfterStep < 300, "max error settled after the step, < 300 us", maxErrorAfterStep);
+
+  // NTP seconds since 1900, the step is part of the mapping by now
+  uint64_t seconds = clock.toTimeTag(deviceBase) >> 32;
+  uint64_t expected = static_cast<uint64_t>((hostBase + STEP) / 1000000) + 2208988800ULL;
+  check(seconds == expected, "time tag seconds of the first event", static_cast<double>(seconds));
+
+  return failures == 0 ? 0 : 1;
+}
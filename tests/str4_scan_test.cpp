@@ -0,0 +1,141 @@
+// str4_scan_test.cpp
+//
+// Checks the block-at-a-time OSC string scanner against the original one,
+// which stepped a word at a time and only looked at the last byte of each.
+// The new scanner also insists on zero padding, so the reference is the
+// original's result with that check added. Buffers are random, mostly
+// zeros and non-zero bytes near each other, in word multiples as strings
+// within a message always are. A few whole messages check that the
+// SuperCollider integer address pattern, a word with a zero first byte, is
+// still accepted in the address slot and only there.
+//
+// built from this directory, the scanner being file-static:
+//   g++ -std=gnu++11 -O2 -I.. str4_scan_test.cpp ../osc/OscTypes.cpp
+// -mno-sse2 covers the word-at-a-time path, -mssse3 the other SIMD one.
+// takes an iteration count, 10000000 by default.
+
+#include "../osc/OscReceivedElements.cpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// the scanner before strict padding, save for reading past end when less
+// than a word remains, which can't happen at word boundaries
+static const char* OriginalFindStr4End( const char *p, const char *end )
+{
+    if( p >= end )
+        return 0;
+
+    if( p[0] == '\0' )    // special case for SuperCollider integer address pattern
+        return p + 4;
+
+    p += 3;
+    end -= 1;
+
+    while( p < end && *p )
+        p += 4;
+
+    if( *p )
+        return 0;
+    else
+        return p + 1;
+}
+
+static const char* ReferenceFindStr4End( const char *p, const char *end )
+{
+    const char *result = OriginalFindStr4End( p, end );
+    if( !result || result > end )
+        return 0;
+
+    const char *terminator = p;
+    while( *terminator )
+        ++terminator;
+    for( const char *padding = terminator; padding < result; ++padding ){
+        if( *padding )
+            return 0;
+    }
+    return result;
+}
+
+static int failures = 0;
+
+static void Compare( const char *buffer, std::size_t size )
+{
+    const char *expected = ReferenceFindStr4End( buffer, buffer + size );
+    const char *actual = osc::FindStr4End( buffer, buffer + size );
+    if( expected != actual && failures++ < 10 ){
+        std::printf( "mismatch, size %u: expected %d, got %d:",
+                (unsigned)size,
+                expected ? (int)(expected - buffer) : -1,
+                actual ? (int)(actual - buffer) : -1 );
+        for( std::size_t i=0; i < size; ++i )
+            std::printf( " %02x", (unsigned char)buffer[i] );
+        std::printf( "\n" );
+    }
+}
+
+static void CheckMessage( const char *name, const char *message, std::size_t size, bool valid )
+{
+    const char *error = osc::ReceivedPacket::Check( message, (osc::osc_bundle_element_size_t)size );
+    if( (error == 0) != valid ){
+        std::printf( "%s: expected %s, got %s\n", name, valid ? "valid" : "an error",
+                error ? error : "valid" );
+        ++failures;
+    }
+}
+
+int main( int argc, char **argv )
+{
+    long iterations = argc > 1 ? std::atol( argv[1] ) : 10000000;
+
+    // fixed cases: empty strings with and without clean padding, and
+    // a string running to the end
+    const char cases[][8] = {
+        { 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 'a', 'b', 'c', 0, 0, 0, 0 },
+        { 0, 0, 0, 1, 0, 0, 0, 0 },
+        { 'a', 0, 0, 0, 0, 0, 0, 0 },
+        { 'a', 0, 'b', 0, 0, 0, 0, 0 },
+        { 'a', 'b', 'c', 'd', 0, 0, 0, 0 },
+        { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h' },
+    };
+    for( std::size_t i=0; i < sizeof(cases) / sizeof(cases[0]); ++i ){
+        Compare( cases[i], 4 );
+        Compare( cases[i], 8 );
+    }
+    if( osc::FindStr4End( cases[1], cases[1] + 8 ) != 0 )
+        std::printf( "empty string with non-zero padding accepted\n" ), ++failures;
+
+    // SuperCollider integer addresses, with and without arguments
+    CheckMessage( "integer address", "\0\0\0\x05,\0\0\0", 8, true );
+    CheckMessage( "integer address only", "\0\0\0\x05", 4, true );
+    CheckMessage( "integer address, int argument", "\0\0\0\x05,i\0\0\0\0\0\x07", 12, true );
+    // but empty type tags and string arguments still need zero padding
+    CheckMessage( "badly padded empty string argument", "/a\0\0,s\0\0\0abc", 12, false );
+    CheckMessage( "badly padded type tags", "/a\0\0,i\0x\0\0\0\x07", 12, false );
+    {
+        osc::ReceivedMessage message( osc::ReceivedPacket( "\0\0\0\x05,\0\0\0", 8 ) );
+        if( !message.AddressPatternIsUInt32() || message.AddressPatternAsUInt32() != 5 )
+            std::printf( "integer address not read back\n" ), ++failures;
+    }
+
+    std::mt19937 rng( 1 );
+    char buffer[128];
+    for( long n=0; n < iterations; ++n ){
+        std::size_t size = 4 * (1 + rng() % (sizeof(buffer) / 4));
+        // a run of non-zero bytes, then mostly zeros with a few strays
+        std::size_t length = rng() % (size + 1);
+        unsigned stray = rng() % 4;
+        for( std::size_t i=0; i < size; ++i ){
+            if( i < length )
+                buffer[i] = (char)(1 + rng() % 255);
+            else
+                buffer[i] = (stray && rng() % 16 == 0) ? (char)(1 + rng() % 255) : 0;
+        }
+        Compare( buffer, size );
+    }
+
+    std::printf( "%ld random buffers, %d mismatches\n", iterations, failures );
+    return failures == 0 ? 0 : 1;
+}